@@ -0,0 +1,162 @@
+#include "SparkFun_u-blox_Cellular_Arduino_Library.h"
+
+// Times SparkFun_ublox_Cellular_Parser against the strnstr + sscanf code it replaced, on the URC lines the driver
+// sees most. Both must read the same values. Runs on a PC: build it with a host Arduino core, such as EpoxyDuino, on
+// Linux or macOS, with optimisation (-O2). See ../README.md
+
+#ifndef UBX_CELL_SIMULATOR_ENABLED
+#error "This benchmark needs a host build (Linux or macOS)"
+#endif
+
+#include <stdio.h>
+
+const unsigned long iterations = 1000000;
+
+// The inputs are volatile, so the compiler cannot fold the work away
+const char *volatile readSocketURC = "+UUSORD: 0,1024";
+const char *volatile closeSocketURC = "+UUSOCL: 3";
+const char *volatile registrationURC = "+CEREG: 5,\"1A2B\",\"01A2B3C4\",7";
+const char *volatile listenURC = "+UUSOLI: 1,\"192.168.1.23\",50123,0,\"10.0.0.2\",8080";
+
+// A checksum of every value read, so both ways of parsing can be compared
+volatile unsigned long checksum = 0;
+
+// sscanf from the start of the text after prefix and any spaces, as the driver used to
+const char *afterPrefix(const char *event, const char *prefix)
+{
+    const char *searchPtr = strnstr(event, prefix, 128);
+    if (searchPtr == nullptr)
+        return nullptr;
+    searchPtr += strlen(prefix);
+    while (*searchPtr == ' ')
+        searchPtr++;
+    return searchPtr;
+}
+
+unsigned long scanReadSocket(void)
+{
+    int socket = 0, length = 0;
+    const char *searchPtr = afterPrefix(readSocketURC, UBX_CELL_READ_SOCKET_URC);
+    if ((searchPtr == nullptr) || (sscanf(searchPtr, "%d,%d", &socket, &length) != 2))
+        return 0;
+    return socket + length;
+}
+
+unsigned long parseReadSocket(void)
+{
+    int socket = 0, length = 0;
+    SparkFun_ublox_Cellular_Parser parser(readSocketURC);
+    parser.find(UBX_CELL_READ_SOCKET_URC).integer(socket).integer(length);
+    if (parser.count() != 2)
+        return 0;
+    return socket + length;
+}
+
+unsigned long scanCloseSocket(void)
+{
+    int socket = 0;
+    const char *searchPtr = afterPrefix(closeSocketURC, UBX_CELL_CLOSE_SOCKET_URC);
+    if ((searchPtr == nullptr) || (sscanf(searchPtr, "%d", &socket) != 1))
+        return 0;
+    return socket;
+}
+
+unsigned long parseCloseSocket(void)
+{
+    int socket = 0;
+    SparkFun_ublox_Cellular_Parser parser(closeSocketURC);
+    parser.find(UBX_CELL_CLOSE_SOCKET_URC).integer(socket);
+    if (parser.count() != 1)
+        return 0;
+    return socket;
+}
+
+unsigned long scanRegistration(void)
+{
+    int status = 0, act = 0;
+    unsigned int tac = 0, ci = 0;
+    const char *searchPtr = afterPrefix(registrationURC, UBX_CELL_EPSREGISTRATION_STATUS_URC);
+    if ((searchPtr == nullptr) || (sscanf(searchPtr, "%d,\"%4x\",\"%8x\",%d", &status, &tac, &ci, &act) != 4))
+        return 0;
+    return status + tac + ci + act;
+}
+
+unsigned long parseRegistration(void)
+{
+    int status = 0, act = 0;
+    unsigned int tac = 0, ci = 0;
+    SparkFun_ublox_Cellular_Parser parser(registrationURC);
+    parser.find(UBX_CELL_EPSREGISTRATION_STATUS_URC).integer(status).hex(tac).hex(ci).integer(act);
+    if (parser.count() != 4)
+        return 0;
+    return status + tac + ci + act;
+}
+
+unsigned long scanListen(void)
+{
+    int socket = 0, listenSocket = 0;
+    int remote[4], local[4];
+    unsigned int port = 0, listenPort = 0;
+    const char *searchPtr = afterPrefix(listenURC, UBX_CELL_LISTEN_SOCKET_URC);
+    if ((searchPtr == nullptr) ||
+        (sscanf(searchPtr, "%d,\"%d.%d.%d.%d\",%u,%d,\"%d.%d.%d.%d\",%u", &socket, &remote[0], &remote[1], &remote[2],
+                &remote[3], &port, &listenSocket, &local[0], &local[1], &local[2], &local[3], &listenPort) != 12))
+        return 0;
+    return socket + remote[0] + remote[3] + port + listenSocket + local[0] + local[3] + listenPort;
+}
+
+unsigned long parseListen(void)
+{
+    int socket = 0, listenSocket = 0;
+    IPAddress remote, local;
+    unsigned int port = 0, listenPort = 0;
+    SparkFun_ublox_Cellular_Parser parser(listenURC);
+    parser.find(UBX_CELL_LISTEN_SOCKET_URC).integer(socket).ipAddress(remote).integer(port).integer(listenSocket);
+    parser.ipAddress(local).integer(listenPort);
+    if (parser.count() != 6)
+        return 0;
+    return socket + remote[0] + remote[3] + port + listenSocket + local[0] + local[3] + listenPort;
+}
+
+// Time iterations calls of parse. Returns nanoseconds per call
+double timeIt(unsigned long (*parse)(void), unsigned long *sum)
+{
+    unsigned long total = 0;
+    unsigned long start = micros();
+    for (unsigned long i = 0; i < iterations; i++)
+        total += parse();
+    unsigned long elapsed = micros() - start;
+    checksum = checksum + total;
+    *sum = total;
+    return (elapsed * 1000.0) / iterations;
+}
+
+void compare(const char *name, unsigned long (*scan)(void), unsigned long (*parse)(void))
+{
+    unsigned long scanSum, parseSum;
+    double scanNs = timeIt(scan, &scanSum);
+    double parseNs = timeIt(parse, &parseSum);
+
+    char line[128];
+    snprintf(line, sizeof(line), "%-10s sscanf %7.1f ns  parser %7.1f ns  speedup %5.1fx  %s", name, scanNs, parseNs,
+             scanNs / parseNs, (scanSum == parseSum) ? "values match" : "VALUES DIFFER");
+    Serial.println(line);
+}
+
+void setup()
+{
+    Serial.begin(115200); // Start the serial console
+
+    Serial.println(F("u-blox Cellular Host Benchmark 1 - Parser vs sscanf"));
+    Serial.println(String(iterations) + " lines of each");
+
+    compare("+UUSORD", scanReadSocket, parseReadSocket);
+    compare("+UUSOCL", scanCloseSocket, parseCloseSocket);
+    compare("+CEREG", scanRegistration, parseRegistration);
+    compare("+UUSOLI", scanListen, parseListen);
+}
+
+void loop()
+{
+    // Nothing to do here
+}
@@ -0,0 +1,145 @@
+#include "SparkFun_u-blox_Cellular_Arduino_Library.h"
+
+// Measures the throughput of SparkFun_ublox_Cellular_Hex, the codec behind socket hex mode (setSocketHexMode),
+// against a simple one-digit-at-a-time codec. Both must produce the same data. Runs on a PC: build it with a host
+// Arduino core, such as EpoxyDuino, on Linux or macOS, with optimisation (-O2). See ../README.md
+
+#ifndef UBX_CELL_SIMULATOR_ENABLED
+#error "This benchmark needs a host build (Linux or macOS)"
+#endif
+
+#include <stdio.h>
+
+const size_t blockSize = 512;         // The most a hex mode +USORD or +USOWR carries
+const unsigned long blocks = 200000; // About 100MB of data each way
+
+char data[blockSize];
+char hexDigits[2 * blockSize];
+char decoded[blockSize];
+
+// A checksum of every byte produced, so the compiler cannot skip the work
+volatile unsigned long checksum = 0;
+
+size_t simpleEncode(const char *src, size_t len, char *dest)
+{
+    const char digits[] = "0123456789ABCDEF";
+    for (size_t i = 0; i < len; i++)
+    {
+        uint8_t b = (uint8_t)src[i];
+        dest[2 * i] = digits[b >> 4];
+        dest[2 * i + 1] = digits[b & 0x0F];
+    }
+    return 2 * len;
+}
+
+int simpleDigit(char c)
+{
+    if ((c >= '0') && (c <= '9'))
+        return c - '0';
+    if ((c >= 'A') && (c <= 'F'))
+        return c - 'A' + 10;
+    if ((c >= 'a') && (c <= 'f'))
+        return c - 'a' + 10;
+    return -1;
+}
+
+bool simpleDecode(const char *src, size_t len, char *dest)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        int high = simpleDigit(src[2 * i]);
+        int low = simpleDigit(src[2 * i + 1]);
+        if ((high < 0) || (low < 0))
+            return false;
+        dest[i] = (char)((high << 4) | low);
+    }
+    return true;
+}
+
+size_t tableEncode(const char *src, size_t len, char *dest)
+{
+    return SparkFun_ublox_Cellular_Hex::encode(src, len, dest);
+}
+
+bool tableDecode(const char *src, size_t len, char *dest)
+{
+    return SparkFun_ublox_Cellular_Hex::decode(src, len, dest);
+}
+
+// Time blocks calls of encode. Returns MB/s of binary data
+double timeEncode(size_t (*encode)(const char *, size_t, char *))
+{
+    unsigned long total = 0;
+    unsigned long start = micros();
+    for (unsigned long i = 0; i < blocks; i++)
+    {
+        data[0] = (char)i; // A different block each time
+        total += encode(data, blockSize, hexDigits);
+        total += (uint8_t)hexDigits[i % (2 * blockSize)];
+    }
+    unsigned long elapsed = micros() - start;
+    checksum = checksum + total;
+    return ((double)blocks * blockSize) / elapsed; // Bytes per microsecond is MB/s
+}
+
+// Time blocks calls of decode. Returns MB/s of binary data, or 0 if any block failed
+double timeDecode(bool (*decode)(const char *, size_t, char *))
+{
+    unsigned long total = 0;
+    bool ok = true;
+    unsigned long start = micros();
+    for (unsigned long i = 0; i < blocks; i++)
+    {
+        hexDigits[1] = "0123456789ABCDEF"[i & 0x0F]; // A different block each time
+        ok &= decode(hexDigits, blockSize, decoded);
+        total += (uint8_t)decoded[i % blockSize];
+    }
+    unsigned long elapsed = micros() - start;
+    checksum = checksum + total;
+    return ok ? ((double)blocks * blockSize) / elapsed : 0.0;
+}
+
+void compare(const char *name, double simpleMBs, double tableMBs, bool match)
+{
+    char line[128];
+    snprintf(line, sizeof(line), "%-7s simple %8.1f MB/s  table %8.1f MB/s  speedup %5.1fx  %s", name, simpleMBs,
+             tableMBs, tableMBs / simpleMBs, match ? "data matches" : "DATA DIFFERS");
+    Serial.println(line);
+}
+
+void setup()
+{
+    Serial.begin(115200); // Start the serial console
+
+    Serial.println(F("u-blox Cellular Host Benchmark 2 - Hex Codec"));
+    Serial.println(String(blocks) + " blocks of " + String((unsigned long)blockSize) + " bytes each way");
+
+    for (size_t i = 0; i < blockSize; i++)
+        data[i] = (char)(i * 37 + 11); // Every byte value turns up
+
+    // Check both codecs agree, on upper and lower case digits, before timing them
+    char simpleDigits[2 * blockSize];
+    simpleEncode(data, blockSize, simpleDigits);
+    tableEncode(data, blockSize, hexDigits);
+    bool encodeMatch = (memcmp(simpleDigits, hexDigits, sizeof(hexDigits)) == 0);
+    for (size_t i = 0; i < sizeof(simpleDigits); i += 3)
+        simpleDigits[i] = tolower(simpleDigits[i]);
+    bool decodeMatch = tableDecode(simpleDigits, blockSize, decoded) && (memcmp(decoded, data, blockSize) == 0);
+    decodeMatch &= simpleDecode(simpleDigits, blockSize, decoded) && (memcmp(decoded, data, blockSize) == 0);
+    simpleDigits[blockSize] = 'G';
+    decodeMatch &= !tableDecode(simpleDigits, blockSize, decoded) && !simpleDecode(simpleDigits, blockSize, decoded);
+
+    double simpleMBs = timeEncode(simpleEncode);
+    double tableMBs = timeEncode(tableEncode);
+    compare("encode", simpleMBs, tableMBs, encodeMatch);
+
+    tableEncode(data, blockSize, hexDigits);
+    simpleMBs = timeDecode(simpleDecode);
+    tableMBs = timeDecode(tableDecode);
+    compare("decode", simpleMBs, tableMBs, decodeMatch);
+}
+
+void loop()
+{
+    // Nothing to do here
+}
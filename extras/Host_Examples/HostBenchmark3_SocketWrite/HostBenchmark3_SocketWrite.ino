@@ -0,0 +1,84 @@
+#include "SparkFun_u-blox_Cellular_Arduino_Library.h"
+
+// Measures socketWrite throughput against the built-in module simulator. A long write is chained into +USOWR commands
+// of up to 1024 bytes, each waiting setPromptDelay after its "@" prompt. The benchmark compares the 50ms the u-blox
+// specification asks for with no delay at all, and binary mode with hex mode (which has no prompt). It runs with the
+// link at full speed and throttled to the baud rate. Every write must reach the module intact. Runs on a PC: build
+// it with a host Arduino core, such as EpoxyDuino, on Linux or macOS. See ../README.md
+
+#ifndef UBX_CELL_SIMULATOR_ENABLED
+#error "This benchmark needs a host build (Linux or macOS): the simulator is not available on this platform"
+#endif
+
+#include <stdio.h>
+
+const int writeSize = 8192; // Eight +USOWR commands in binary mode, sixteen in hex mode
+
+SparkFun_ublox_Cellular_Simulator mySimulator;
+SparkFun_ublox_Cellular myModule;
+
+char data[writeSize];
+int socket = -1;
+
+void run(const char *name, unsigned long promptDelay, bool hexMode, bool throttle)
+{
+    myModule.setPromptDelay(promptDelay);
+    myModule.setSocketHexMode(hexMode);
+    mySimulator.setThrottle(throttle);
+
+    size_t writtenBefore = mySimulator.socketWritten(socket).length();
+    unsigned long commandsBefore = mySimulator.commandCount();
+    unsigned long start = micros();
+    UBX_CELL_error_t err = myModule.socketWrite(socket, data, writeSize);
+    unsigned long elapsed = micros() - start;
+    unsigned long commands = mySimulator.commandCount() - commandsBefore;
+
+    const std::string &written = mySimulator.socketWritten(socket);
+    bool intact = (err == UBX_CELL_ERROR_SUCCESS) && (written.length() == writtenBefore + writeSize) &&
+                  (memcmp(written.data() + writtenBefore, data, writeSize) == 0);
+
+    char line[128];
+    snprintf(line, sizeof(line), "%-30s %2lu commands %8.1f ms %8.1f kB/s  %s", name, commands, elapsed / 1000.0,
+             (writeSize * 1000.0) / elapsed, intact ? "data intact" : "DATA LOST");
+    Serial.println(line);
+}
+
+void setup()
+{
+    Serial.begin(115200); // Start the serial console
+
+    Serial.println(F("u-blox Cellular Host Benchmark 3 - Socket Write"));
+    Serial.println(String(writeSize) + " bytes per write");
+
+    // myModule.enableDebugging(); // Uncomment this line to enable helpful debug messages on Serial
+
+    if (!myModule.begin(mySimulator, UBX_CELL_DEFAULT_BAUD_RATE))
+    {
+        Serial.println(F("begin failed"));
+        while (1)
+            ; // Loop forever on fail
+    }
+
+    socket = myModule.socketOpen(UBX_CELL_TCP);
+    if ((socket < 0) || (myModule.socketConnect(socket, "192.168.0.1", 80) != UBX_CELL_ERROR_SUCCESS))
+    {
+        Serial.println(F("Socket open failed"));
+        while (1)
+            ; // Loop forever on fail
+    }
+
+    for (int i = 0; i < writeSize; i++)
+        data[i] = (char)(i * 37 + 11); // Binary data: every byte value turns up
+
+    run("binary, 50ms prompt delay", UBX_CELL_PROMPT_DELAY, false, false);
+    run("binary, no prompt delay", 0, false, false);
+    run("hex", 0, true, false);
+    run("throttled binary, 50ms delay", UBX_CELL_PROMPT_DELAY, false, true);
+    run("throttled binary, no delay", 0, false, true);
+    run("throttled hex", 0, true, true);
+}
+
+void loop()
+{
+    // Nothing to do here
+}
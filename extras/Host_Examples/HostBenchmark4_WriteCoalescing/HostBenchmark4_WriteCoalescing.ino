@@ -0,0 +1,152 @@
+#include "SparkFun_u-blox_Cellular_Arduino_Library.h"
+
+// Measures socket write coalescing (setSocketWriteBuffer) against the built-in module simulator. Many small
+// socketWrites each cost a +USOWR command and its prompt delay. With a write buffer they share a few commands. The
+// benchmark counts the +USOWR commands and times the writes both ways, then checks each flush trigger: a full
+// buffer, the flush delay (via bufferedPoll), socketFlush and a write too big for the buffer. Every step is checked:
+// the sketch prints PASS or FAIL. Runs on a PC: build it with a host Arduino core, such as EpoxyDuino, on Linux or
+// macOS. See ../README.md
+
+#ifndef UBX_CELL_SIMULATOR_ENABLED
+#error "This benchmark needs a host build (Linux or macOS): the simulator is not available on this platform"
+#endif
+
+#include <stdio.h>
+
+const int writes = 64;      // Small writes, like a sketch printing a line at a time
+const int writeSize = 16;   // 1024 bytes in all
+const int bufferSize = 512; // Filled by 32 writes
+
+SparkFun_ublox_Cellular_Simulator mySimulator;
+SparkFun_ublox_Cellular myModule;
+
+int socket = -1;
+unsigned long writeCommands = 0; // +USOWR commands the simulator has seen
+bool failed = false;
+
+void check(bool ok, const char *what)
+{
+    Serial.print(ok ? F("pass: ") : F("FAIL: "));
+    Serial.println(what);
+    if (!ok)
+        failed = true;
+}
+
+// The data of write number n
+void fill(char *data, int n, int size)
+{
+    for (int i = 0; i < size; i++)
+        data[i] = (char)(n * 31 + i);
+}
+
+// Call socketWrite writes times, with writeSize bytes each. Checks the data arrived in order. Returns microseconds
+unsigned long writeAll(const char *what)
+{
+    size_t writtenBefore = mySimulator.socketWritten(socket).length();
+    std::string expected;
+    bool ok = true;
+
+    unsigned long start = micros();
+    for (int n = 0; n < writes; n++)
+    {
+        char data[writeSize];
+        fill(data, n, writeSize);
+        ok &= (myModule.socketWrite(socket, data, writeSize) == UBX_CELL_ERROR_SUCCESS);
+        expected.append(data, writeSize);
+    }
+    unsigned long elapsed = micros() - start;
+
+    ok &= (mySimulator.socketWritten(socket).substr(writtenBefore) == expected);
+    check(ok, what);
+    return elapsed;
+}
+
+void setup()
+{
+    Serial.begin(115200); // Start the serial console
+
+    Serial.println(F("u-blox Cellular Host Benchmark 4 - Write Coalescing"));
+
+    // myModule.enableDebugging(); // Uncomment this line to enable helpful debug messages on Serial
+
+    if (!myModule.begin(mySimulator, UBX_CELL_DEFAULT_BAUD_RATE))
+    {
+        Serial.println(F("begin failed"));
+        while (1)
+            ; // Loop forever on fail
+    }
+
+    // Count each +USOWR, then let the simulator's own handler deal with it
+    mySimulator.onCommand("+USOWR", [](const char *command) {
+        (void)command;
+        writeCommands++;
+        return false;
+    });
+
+    socket = myModule.socketOpen(UBX_CELL_TCP);
+    check((socket >= 0) && (myModule.socketConnect(socket, "192.168.0.1", 80) == UBX_CELL_ERROR_SUCCESS),
+          "socket open");
+
+    // Straight through: one +USOWR, and one prompt delay, per write
+    writeCommands = 0;
+    unsigned long unbuffered = writeAll("unbuffered writes arrived in order");
+    check(writeCommands == writes, "one +USOWR per unbuffered write");
+    unsigned long unbufferedCommands = writeCommands;
+
+    // Buffered, with a flush delay long enough that only a full buffer sends it
+    check(myModule.setSocketWriteBuffer(socket, bufferSize, 60000), "setSocketWriteBuffer");
+    writeCommands = 0;
+    unsigned long buffered = writeAll("buffered writes arrived in order");
+    check(writeCommands == (writes * writeSize) / bufferSize, "one +USOWR per full buffer");
+    check(myModule.socketBuffered(socket) == 0, "nothing left in the buffer");
+    unsigned long bufferedCommands = writeCommands;
+
+    char line[128];
+    snprintf(line, sizeof(line), "%d writes of %d bytes: unbuffered %lu +USOWR %.1f ms, buffered %lu +USOWR %.1f ms",
+             writes, writeSize, unbufferedCommands, unbuffered / 1000.0, bufferedCommands, buffered / 1000.0);
+    Serial.println(line);
+
+    // The flush delay: bufferedPoll sends the data once it has waited that long
+    const unsigned long flushDelay = 20;
+    char data[writeSize];
+    fill(data, 0, writeSize);
+    check(myModule.setSocketWriteBuffer(socket, bufferSize, flushDelay), "setSocketWriteBuffer with a 20ms delay");
+    writeCommands = 0;
+    unsigned long start = millis();
+    myModule.socketWrite(socket, data, writeSize);
+    check((writeCommands == 0) && (myModule.socketBuffered(socket) == writeSize), "small write held in the buffer");
+    while ((myModule.socketBuffered(socket) > 0) && (millis() - start < 1000))
+        myModule.bufferedPoll();
+    unsigned long waited = millis() - start;
+    check((writeCommands == 1) && (waited >= flushDelay), "bufferedPoll sent it after the flush delay");
+    Serial.println("Sent after " + String(waited) + " ms, including the +USOWR itself");
+
+    // socketFlush sends it straight away
+    check(myModule.setSocketWriteBuffer(socket, bufferSize, 60000), "setSocketWriteBuffer with a long delay");
+    writeCommands = 0;
+    myModule.socketWrite(socket, data, writeSize);
+    myModule.bufferedPoll();
+    check(writeCommands == 0, "bufferedPoll left it before the flush delay");
+    check((myModule.socketFlush(socket) == UBX_CELL_ERROR_SUCCESS) && (writeCommands == 1) &&
+              (myModule.socketBuffered(socket) == 0),
+          "socketFlush sent it");
+
+    // A write bigger than the buffer sends what is buffered first, then goes straight through
+    size_t writtenBefore = mySimulator.socketWritten(socket).length();
+    char big[bufferSize + 100];
+    fill(big, 1, sizeof(big));
+    writeCommands = 0;
+    myModule.socketWrite(socket, data, writeSize);
+    myModule.socketWrite(socket, big, sizeof(big));
+    std::string expected(data, writeSize);
+    expected.append(big, sizeof(big));
+    check((writeCommands == 2) && (mySimulator.socketWritten(socket).substr(writtenBefore) == expected),
+          "big write sent the buffer first, then itself");
+
+    Serial.println(failed ? F("FAIL") : F("PASS"));
+}
+
+void loop()
+{
+    // Nothing to do here
+}
@@ -0,0 +1,116 @@
+#include "SparkFun_u-blox_Cellular_Arduino_Library.h"
+
+// Measures how fast the driver takes in serial data, against the built-in module simulator. The block-read path
+// (rxRingFill: one read per block, through _rxStage straight into the RX ring) is compared with the per-byte loop
+// it replaced (hwAvailable and readChar for every byte). Both tokenize the same URCs into the ring. Runs on a PC:
+// build it with a host Arduino core, such as EpoxyDuino, on Linux or macOS, with optimisation (-O2). See ../README.md
+
+#ifndef UBX_CELL_SIMULATOR_ENABLED
+#error "This benchmark needs a host build (Linux or macOS): the simulator is not available on this platform"
+#endif
+
+#include <stdio.h>
+
+const unsigned long rounds = 20000; // Each round is one of each URC: about 2MB in all
+
+const char *const urcs[] = {"+UUSORD: 0,1024", "+CEREG: 5,\"1A2B\",\"01A2B3C4\",7", "+UUSOCL: 3",
+                            "+UUSOLI: 1,\"192.168.1.23\",50123,0,\"10.0.0.2\",8080"};
+
+// The RX path is protected, so the benchmark reaches it through a subclass
+class BenchmarkModule : public SparkFun_ublox_Cellular
+{
+  public:
+    // Block reads: drain the serial port into the ring with rxRingFill, as bufferedPoll does
+    unsigned long drainBlocks(void)
+    {
+        unsigned long total = 0;
+        int numRead;
+        while ((numRead = rxRingFill()) > 0)
+        {
+            total += numRead;
+            discardEvents();
+        }
+        return total;
+    }
+
+    // The per-byte loop: ask hwAvailable, then readChar one byte into the ring
+    unsigned long drainBytes(void)
+    {
+        unsigned long total = 0;
+        while (hwAvailable() > 0)
+        {
+            rxRingPut(readChar());
+            total++;
+            if (_rxEventCount > 0)
+                discardEvents();
+        }
+        return total;
+    }
+
+    // Both paths drop the events they index, so neither is limited by the event index
+    void discardEvents(void)
+    {
+        while (_rxEventCount > 0)
+            rxRingPop();
+    }
+};
+
+SparkFun_ublox_Cellular_Simulator mySimulator;
+BenchmarkModule myModule;
+
+// Queue rounds of every URC. Returns the number of bytes queued
+unsigned long queueURCs(void)
+{
+    unsigned long total = 0;
+    for (unsigned long i = 0; i < rounds; i++)
+    {
+        for (size_t u = 0; u < sizeof(urcs) / sizeof(urcs[0]); u++)
+        {
+            mySimulator.injectURC(urcs[u]);
+            total += strlen(urcs[u]) + 4; // The simulator frames each URC with \r\n
+        }
+    }
+    return total;
+}
+
+// Time one way of draining the queued URCs. Returns MB/s
+double timeIt(const char *name, unsigned long (BenchmarkModule::*drain)(void), unsigned long expected)
+{
+    unsigned long start = micros();
+    unsigned long total = (myModule.*drain)();
+    unsigned long elapsed = micros() - start;
+    double mbs = (double)total / elapsed; // Bytes per microsecond is MB/s
+
+    char line[128];
+    snprintf(line, sizeof(line), "%-12s %8lu bytes %8.1f ms %8.1f MB/s  %s", name, total, elapsed / 1000.0, mbs,
+             (total == expected) ? "all bytes read" : "BYTES MISSING");
+    Serial.println(line);
+    return mbs;
+}
+
+void setup()
+{
+    Serial.begin(115200); // Start the serial console
+
+    Serial.println(F("u-blox Cellular Host Benchmark 5 - RX Path"));
+
+    if (!myModule.begin(mySimulator, UBX_CELL_DEFAULT_BAUD_RATE))
+    {
+        Serial.println(F("begin failed"));
+        while (1)
+            ; // Loop forever on fail
+    }
+    myModule.bufferedPoll(); // Start with nothing waiting
+
+    double perByte = timeIt("per byte", &BenchmarkModule::drainBytes, queueURCs());
+    double block = timeIt("block reads", &BenchmarkModule::drainBlocks, queueURCs());
+
+    char line[64];
+    snprintf(line, sizeof(line), "speedup %.1fx", block / perByte);
+    Serial.println(line);
+}
+
+void loop()
+{
+    // Nothing to do here
+}
@@ -0,0 +1,109 @@
+#include "SparkFun_u-blox_Cellular_Arduino_Library.h"
+
+// Runs the driver against the built-in module simulator, on a PC. No module or board is needed.
+// Build it with a host Arduino core, such as EpoxyDuino, on Linux or macOS. See ../README.md
+
+#ifndef UBX_CELL_SIMULATOR_ENABLED
+#error "This example needs a host build (Linux or macOS): the simulator is not available on this platform"
+#endif
+
+SparkFun_ublox_Cellular_Simulator mySimulator;
+SparkFun_ublox_Cellular myModule;
+
+volatile unsigned long socketCloses = 0;
+
+// processSocketClose is provided to the u-blox cellular library via a
+// callback setter -- setSocketCloseCallback. (See setup())
+void processSocketClose(int socket)
+{
+    (void)socket;
+    socketCloses++;
+}
+
+void setup()
+{
+    Serial.begin(115200); // Start the serial console
+
+    Serial.println(F("u-blox Cellular Host Example 1 - Simulator"));
+
+    // myModule.enableDebugging(); // Uncomment this line to enable helpful debug messages on Serial
+
+    // The simulator is a transport: the driver talks to it directly, at full speed
+    if (!myModule.begin(mySimulator, UBX_CELL_DEFAULT_BAUD_RATE))
+    {
+        Serial.println(F("begin failed"));
+        while (1)
+            ; // Loop forever on fail
+    }
+
+    // A raw command and its response
+    char response[minimumResponseAllocation];
+    UBX_CELL_error_t err = myModule.sendCommandWithResponse("+CGMI", UBX_CELL_RESPONSE_OK, response,
+                                                            UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+    Serial.print(F("AT+CGMI:             "));
+    Serial.println(err == UBX_CELL_ERROR_SUCCESS ? F("OK") : F("failed"));
+
+    // Script a response of our own
+    mySimulator.setResponse("+CSQ", "\r\n+CSQ: 17,99\r\n\r\nOK\r\n");
+    Serial.println("RSSI:                " + String(myModule.rssi()));
+
+    // Sockets: open, connect, write, then receive data which the 'remote end' sends
+    int socket = myModule.socketOpen(UBX_CELL_TCP);
+    if ((socket < 0) || (myModule.socketConnect(socket, "192.168.0.1", 80) != UBX_CELL_ERROR_SUCCESS))
+    {
+        Serial.println(F("Socket open failed"));
+        while (1)
+            ; // Loop forever on fail
+    }
+
+    const char request[] = "GET / HTTP/1.0\r\n\r\n";
+    myModule.socketWrite(socket, request);
+    Serial.print(F("Module received:     "));
+    Serial.print(String(mySimulator.socketWritten(socket).length()));
+    Serial.println(F(" bytes"));
+
+    const char reply[] = "HTTP/1.0 200 OK\r\n\r\nHello";
+    mySimulator.injectSocketData(socket, reply, strlen(reply));
+    char data[64];
+    int bytesRead = 0;
+    myModule.socketRead(socket, sizeof(data), data, &bytesRead);
+    Serial.print(F("Socket read:         "));
+    Serial.print(String(bytesRead));
+    Serial.println(F(" bytes"));
+
+    // A URC storm: 1000 +UUSOCL URCs, one every 100 microseconds, processed by bufferedPoll
+    myModule.setSocketCloseCallback(&processSocketClose);
+    mySimulator.startURCStorm("+UUSOCL: 1", 100, 1000);
+    unsigned long start = millis();
+    while ((socketCloses < 1000) && (millis() - start < 5000))
+        myModule.bufferedPoll();
+    Serial.print(F("URCs handled:        "));
+    Serial.print(String(socketCloses));
+    Serial.print(F(" in "));
+    Serial.print(String(millis() - start));
+    Serial.println(F(" ms"));
+
+    // A URC storm during a slow command: 150 URCs arrive while AT+CGMI waits 100ms for its response. That is more
+    // than the 64 events the backlog can index, so the driver merges them. None are lost
+    socketCloses = 0;
+    mySimulator.setLatency(100000);
+    mySimulator.startURCStorm("+UUSOCL: 1", 100, 150);
+    myModule.sendCommandWithResponse("+CGMI", UBX_CELL_RESPONSE_OK, response, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+    mySimulator.setLatency(0);
+    start = millis();
+    while ((socketCloses < 150) && (millis() - start < 5000))
+        myModule.bufferedPoll();
+    Serial.print(F("URCs during command: "));
+    Serial.print(String(socketCloses));
+    Serial.println(F(" of 150"));
+
+    myModule.socketClose(socket);
+
+    Serial.print(F("Commands sent:       "));
+    Serial.println(String(mySimulator.commandCount()));
+}
+
+void loop()
+{
+    // Nothing to do here
+}
@@ -0,0 +1,124 @@
+#include "SparkFun_u-blox_Cellular_Arduino_Library.h"
+
+// Asynchronous commands, against the built-in module simulator. Each command's callback sends the next one, while
+// the sketch carries on with blocking calls of its own. Then an operator scan runs in the background. Every step is
+// checked: the sketch prints PASS or FAIL.
+// Runs on a PC: build it with a host Arduino core, such as EpoxyDuino, on Linux or macOS. See ../README.md
+
+#ifndef UBX_CELL_SIMULATOR_ENABLED
+#error "This example needs a host build (Linux or macOS): the simulator is not available on this platform"
+#endif
+
+SparkFun_ublox_Cellular_Simulator mySimulator;
+SparkFun_ublox_Cellular myModule;
+
+int closeSocket = -1;
+char csqResponse[minimumResponseAllocation];
+volatile int chainStep = 0;   // 0: +CSQ in progress, 1: +USOCL in progress, 2: both done
+struct operator_stats operators[3]; // Filled in by getOperatorsAsync
+volatile int operatorsSeen = -1;   // Set by processOperators
+volatile bool failed = false;
+
+void check(bool ok, const char *what)
+{
+    Serial.print(ok ? F("pass: ") : F("FAIL: "));
+    Serial.println(what);
+    if (!ok)
+        failed = true;
+}
+
+// processClose is called when +USOCL (the second command of the chain) completes
+void processClose(UBX_CELL_command_handle_t handle, UBX_CELL_error_t result, const char *response)
+{
+    (void)handle;
+    (void)response;
+    check(result == UBX_CELL_ERROR_SUCCESS, "chained +USOCL completed");
+    chainStep = 2;
+}
+
+// processCSQ is called when +CSQ completes. It starts the next command of the chain
+void processCSQ(UBX_CELL_command_handle_t handle, UBX_CELL_error_t result, const char *response)
+{
+    (void)handle;
+    check((result == UBX_CELL_ERROR_SUCCESS) && (strstr(response, "+CSQ: 17,99") != nullptr), "+CSQ completed");
+    check(myModule.socketCloseAsync(closeSocket, processClose) != UBX_CELL_COMMAND_HANDLE_INVALID,
+          "callback sent +USOCL");
+    chainStep = 1;
+}
+
+// processOperators is called when +COPS=? completes, after the operators have been stored in operators[]
+void processOperators(UBX_CELL_command_handle_t handle, UBX_CELL_error_t result, uint8_t numOps)
+{
+    (void)handle;
+    check(result == UBX_CELL_ERROR_SUCCESS, "+COPS=? completed");
+    operatorsSeen = numOps;
+}
+
+void setup()
+{
+    Serial.begin(115200); // Start the serial console
+
+    Serial.println(F("u-blox Cellular Host Example 2 - Asynchronous Commands"));
+
+    // myModule.enableDebugging(); // Uncomment this line to enable helpful debug messages on Serial
+
+    if (!myModule.begin(mySimulator, UBX_CELL_DEFAULT_BAUD_RATE))
+    {
+        Serial.println(F("begin failed"));
+        while (1)
+            ; // Loop forever on fail
+    }
+
+    mySimulator.setResponse("+CSQ", "\r\n+CSQ: 17,99\r\n\r\nOK\r\n");
+    mySimulator.setLatency(2000); // 2ms before each response: long enough for the blocking call to catch +CSQ in flight
+
+    int readSocket = myModule.socketOpen(UBX_CELL_TCP);
+    closeSocket = myModule.socketOpen(UBX_CELL_TCP);
+    const char data[] = "Some data for the blocking read";
+    mySimulator.injectSocketData(readSocket, data, strlen(data));
+    myModule.bufferedPoll(); // Collect the +UUSORD
+
+    // Start the chain, then do a blocking read while +CSQ is still in progress. socketRead builds its +USORD first,
+    // then waits for +CSQ to complete. processCSQ must not run until the read is done: its +USOCL would take the place
+    // of the +USORD
+    UBX_CELL_command_handle_t csq = myModule.sendCommandAsync("+CSQ", UBX_CELL_RESPONSE_OK, processCSQ, csqResponse);
+    check(csq != UBX_CELL_COMMAND_HANDLE_INVALID, "+CSQ sent");
+
+    char readData[64];
+    int bytesRead = 0;
+    UBX_CELL_error_t err = myModule.socketRead(readSocket, strlen(data), readData, &bytesRead);
+    check((err == UBX_CELL_ERROR_SUCCESS) && (bytesRead == (int)strlen(data)) &&
+              (memcmp(readData, data, bytesRead) == 0),
+          "blocking socketRead while +CSQ was in progress");
+    check(chainStep == 0, "+CSQ callback held back during the blocking call");
+    check(myModule.commandResult(csq) == UBX_CELL_ERROR_SUCCESS, "+CSQ result");
+
+    // bufferedPoll calls processCSQ, which sends +USOCL. Then bufferedPoll collects its response
+    unsigned long start = millis();
+    while ((chainStep < 2) && (millis() - start < 1000))
+        myModule.bufferedPoll();
+    check(chainStep == 2, "chain completed by bufferedPoll");
+
+    // A blocking command after the chain
+    check(myModule.rssi() == 17, "blocking rssi after the chain");
+
+    // An operator scan takes up to three minutes on a real module. getOperatorsAsync parses the response into the
+    // array when the command completes
+    mySimulator.setResponse("+COPS=?", "\r\n+COPS: (1,\"313 100\",\"313 100\",\"313100\",8),"
+                                       "(2,\"AT&T\",\"AT&T\",\"310410\",7),,(0,1,2,3,4),(0,1,2)\r\n\r\nOK\r\n");
+    check(myModule.getOperatorsAsync(operators, 3, processOperators) != UBX_CELL_COMMAND_HANDLE_INVALID,
+          "+COPS=? sent");
+    start = millis();
+    while ((operatorsSeen < 0) && (millis() - start < 1000))
+        myModule.bufferedPoll();
+    check((operatorsSeen == 2) && (operators[0].numOp == 313100) && (operators[1].shortOp == "AT&T") &&
+              (operators[1].act == 7),
+          "operators stored by getOperatorsAsync");
+
+    Serial.println(failed ? F("FAIL") : F("PASS"));
+}
+
+void loop()
+{
+    // Nothing to do here
+}
@@ -1,4 +1,14 @@
 #include "sfe_lara_r6.h"
 #include "sfe_sara_r5.h"
 #include "sfe_ublox_cellular.h"
+#include "sfe_ublox_cellular_arena.h"
+#include "sfe_ublox_cellular_client.h"
+#include "sfe_ublox_cellular_cmux.h"
+#include "sfe_ublox_cellular_command.h"
+#include "sfe_ublox_cellular_direct_link.h"
+#include "sfe_ublox_cellular_hex.h"
+#include "sfe_ublox_cellular_matcher.h"
+#include "sfe_ublox_cellular_parser.h"
+#include "sfe_ublox_cellular_simulator.h"
+#include "sfe_ublox_cellular_transport_posix.h"
 #include "sfe_ublox_cellular_voice.h"
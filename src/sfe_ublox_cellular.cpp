@@ -14,6 +14,7 @@
 */
 
 #include "sfe_ublox_cellular.h"
+#include "sfe_ublox_cellular_client.h"
 
 SparkFun_ublox_Cellular::SparkFun_ublox_Cellular(int powerPin, int resetPin, uint8_t maxInitTries)
 {
@@ -21,7 +22,15 @@ SparkFun_ublox_Cellular::SparkFun_ublox_Cellular(int powerPin, int resetPin, uin
     _softSerial = nullptr;
 #endif
     _hardSerial = nullptr;
+    _transport = nullptr;
     _baud = 0;
+    _linkThroughput = 0;
+    _mux = nullptr;
+    _muxHardSerial = nullptr;
+#ifdef UBX_CELL_SOFTWARE_SERIAL_ENABLED
+    _muxSoftSerial = nullptr;
+#endif
+    _muxTransport = nullptr;
     _resetPin = resetPin;
     _powerPin = powerPin;
     _invertPowerPin = false;
@@ -44,14 +53,35 @@ SparkFun_ublox_Cellular::SparkFun_ublox_Cellular(int powerPin, int resetPin, uin
     _lastRemoteIP = {0, 0, 0, 0};
     _lastLocalIP = {0, 0, 0, 0};
     for (int i = 0; i < UBX_CELL_NUM_SOCKETS; i++)
+    {
         _lastSocketProtocol[i] = 0; // Set to zero initially. Will be set to TCP/UDP by socketOpen etc.
+        _socketClients[i] = nullptr;
+        _socketWriteBuffers[i] = {nullptr, 0, 0, 0, 0};
+    }
     _autoTimeZoneForBegin = true;
     _bufferedPollReentrant = false;
     _pollReentrant = false;
-    _saraResponseBacklogLength = 0;
-    _saraRXBuffer = nullptr;
-    _pruneBuffer = nullptr;
-    _saraResponseBacklog = nullptr;
+    _rxRing = nullptr;
+    rxRingReset();
+    _lastResult = {UBX_CELL_ERROR_SUCCESS, UBX_CELL_RESULT_NONE, -1};
+    _rxStageHead = 0;
+    _rxStageTail = 0;
+    _txQueue = nullptr;
+    _txQueueSize = 0;
+    _txQueueHead = 0;
+    _txQueueTail = 0;
+    _txQueueUsed = 0;
+    _txWouldBlock = 0;
+    _txPartialWrites = 0;
+    _rxFeed = nullptr;
+    _rxFeedSize = 0;
+    _rxFeedHead = 0;
+    _rxFeedTail = 0;
+    _rxFeedOverruns = 0;
+    _rxWakeResponse = '\n';
+    _rxWakeError = '\n';
+    _rxWaitCallback = nullptr;
+    _rxNotifyCallback = nullptr;
 
     // Add base URC handlers
     addURCHandler(UBX_CELL_READ_SOCKET_URC, [this](const char *event) { return this->urcHandlerReadSocket(event); });
@@ -75,61 +105,47 @@ SparkFun_ublox_Cellular::SparkFun_ublox_Cellular(int powerPin, int resetPin, uin
 
 SparkFun_ublox_Cellular::~SparkFun_ublox_Cellular(void)
 {
-    if (nullptr != _saraRXBuffer)
+    if (nullptr != _rxRing)
     {
-        delete[] _saraRXBuffer;
-        _saraRXBuffer = nullptr;
+        delete[] _rxRing;
+        _rxRing = nullptr;
     }
-    if (nullptr != _pruneBuffer)
+    if (nullptr != _txQueue)
     {
-        delete[] _pruneBuffer;
-        _pruneBuffer = nullptr;
+        delete[] _txQueue;
+        _txQueue = nullptr;
     }
-    if (nullptr != _saraResponseBacklog)
+    for (int i = 0; i < UBX_CELL_NUM_SOCKETS; i++)
+        freeSocketWriteBuffer(i);
+    if (nullptr != _asyncOperatorsResponse)
     {
-        delete[] _saraResponseBacklog;
-        _saraResponseBacklog = nullptr;
+        free(_asyncOperatorsResponse);
+        _asyncOperatorsResponse = nullptr;
     }
+    disableRxFeed();
 }
 
 #ifdef UBX_CELL_SOFTWARE_SERIAL_ENABLED
 bool SparkFun_ublox_Cellular::begin(SoftwareSerial &softSerial, unsigned long baud)
 {
-    if (nullptr == _saraRXBuffer)
-    {
-        _saraRXBuffer = new char[_RXBuffSize];
-        if (nullptr == _saraRXBuffer)
-        {
-            if (_printDebug == true)
-                _debugPort->println(F("begin: not enough memory for _saraRXBuffer!"));
-            return false;
-        }
-    }
-    memset(_saraRXBuffer, 0, _RXBuffSize);
-
-    if (nullptr == _pruneBuffer)
+    if (nullptr == _rxRing)
     {
-        _pruneBuffer = new char[_RXBuffSize];
-        if (nullptr == _pruneBuffer)
+        _rxRing = new char[_RXBuffSize + _RXEventSlack];
+        if (nullptr == _rxRing)
         {
             if (_printDebug == true)
-                _debugPort->println(F("begin: not enough memory for _pruneBuffer!"));
+                _debugPort->println(F("begin: not enough memory for _rxRing!"));
             return false;
         }
     }
-    memset(_pruneBuffer, 0, _RXBuffSize);
+    rxRingReset();
 
-    if (nullptr == _saraResponseBacklog)
+    if (!_arena.begin(_arenaSize))
     {
-        _saraResponseBacklog = new char[_RXBuffSize];
-        if (nullptr == _saraResponseBacklog)
-        {
-            if (_printDebug == true)
-                _debugPort->println(F("begin: not enough memory for _saraResponseBacklog!"));
-            return false;
-        }
+        if (_printDebug == true)
+            _debugPort->println(F("begin: not enough memory for the response arena!"));
+        return false;
     }
-    memset(_saraResponseBacklog, 0, _RXBuffSize);
 
     UBX_CELL_error_t err;
 
@@ -146,41 +162,24 @@ bool SparkFun_ublox_Cellular::begin(SoftwareSerial &softSerial, unsigned long ba
 
 bool SparkFun_ublox_Cellular::begin(HardwareSerial &hardSerial, unsigned long baud)
 {
-    if (nullptr == _saraRXBuffer)
-    {
-        _saraRXBuffer = new char[_RXBuffSize];
-        if (nullptr == _saraRXBuffer)
-        {
-            if (_printDebug == true)
-                _debugPort->println(F("begin: not enough memory for _saraRXBuffer!"));
-            return false;
-        }
-    }
-    memset(_saraRXBuffer, 0, _RXBuffSize);
-
-    if (nullptr == _pruneBuffer)
+    if (nullptr == _rxRing)
     {
-        _pruneBuffer = new char[_RXBuffSize];
-        if (nullptr == _pruneBuffer)
+        _rxRing = new char[_RXBuffSize + _RXEventSlack];
+        if (nullptr == _rxRing)
         {
             if (_printDebug == true)
-                _debugPort->println(F("begin: not enough memory for _pruneBuffer!"));
+                _debugPort->println(F("begin: not enough memory for _rxRing!"));
             return false;
         }
     }
-    memset(_pruneBuffer, 0, _RXBuffSize);
+    rxRingReset();
 
-    if (nullptr == _saraResponseBacklog)
+    if (!_arena.begin(_arenaSize))
     {
-        _saraResponseBacklog = new char[_RXBuffSize];
-        if (nullptr == _saraResponseBacklog)
-        {
-            if (_printDebug == true)
-                _debugPort->println(F("begin: not enough memory for _saraResponseBacklog!"));
-            return false;
-        }
+        if (_printDebug == true)
+            _debugPort->println(F("begin: not enough memory for the response arena!"));
+        return false;
     }
-    memset(_saraResponseBacklog, 0, _RXBuffSize);
 
     UBX_CELL_error_t err;
 
@@ -194,6 +193,33 @@ bool SparkFun_ublox_Cellular::begin(HardwareSerial &hardSerial, unsigned long ba
     //return false;
 }
 
+bool SparkFun_ublox_Cellular::begin(SparkFun_ublox_Cellular_Transport &transport, unsigned long baud)
+{
+    if (nullptr == _rxRing)
+    {
+        _rxRing = new char[_RXBuffSize + _RXEventSlack];
+        if (nullptr == _rxRing)
+        {
+            if (_printDebug == true)
+                _debugPort->println(F("begin: not enough memory for _rxRing!"));
+            return false;
+        }
+    }
+    rxRingReset();
+
+    if (!_arena.begin(_arenaSize))
+    {
+        if (_printDebug == true)
+            _debugPort->println(F("begin: not enough memory for the response arena!"));
+        return false;
+    }
+
+    _transport = &transport;
+    _transport->begin(baud);
+
+    return true;
+}
+
 // Calling this function with nothing sets the debug port to Serial
 // You can also call it with other streams like Serial1, SerialUSB, etc.
 void SparkFun_ublox_Cellular::enableDebugging(Print &debugPort)
@@ -210,6 +236,186 @@ void SparkFun_ublox_Cellular::enableAtDebugging(Print &debugPort)
     _printAtDebug = true;
 }
 
+UBX_CELL_result_t SparkFun_ublox_Cellular::getLastResult(void)
+{
+    return _lastResult;
+}
+
+bool SparkFun_ublox_Cellular::setArenaSize(size_t size)
+{
+    _arenaSize = size;
+    if (_arena.size() == 0)
+        return true; // begin will allocate it
+    return _arena.begin(size);
+}
+
+// Response buffers come from the arena. One which does not fit comes from the heap instead, as they all did before
+char *SparkFun_ublox_Cellular::responseAlloc(size_t size)
+{
+    char *response = _arena.alloc(size);
+    if (response == nullptr)
+    {
+        if (_printDebug == true)
+        {
+            _debugPort->print(F("responseAlloc: arena full. Using the heap for "));
+            _debugPort->println(size);
+        }
+        response = ubx_cell_calloc_char(size);
+    }
+    return response;
+}
+
+void SparkFun_ublox_Cellular::responseRelease(char *response, size_t arenaMark)
+{
+    if ((response != nullptr) && (!_arena.contains(response)))
+        free(response);
+    _arena.release(arenaMark);
+}
+
+bool SparkFun_ublox_Cellular::enableTxQueue(size_t size)
+{
+    if ((size < 1) || (size > 32768))
+        return false;
+
+    disableTxQueue();
+
+    _txQueue = new char[size];
+    if (nullptr == _txQueue)
+    {
+        if (_printDebug == true)
+            _debugPort->println(F("enableTxQueue: not enough memory for _txQueue!"));
+        return false;
+    }
+
+    _txQueueSize = (int)size;
+    _txQueueHead = 0;
+    _txQueueTail = 0;
+    _txQueueUsed = 0;
+    _txWouldBlock = 0;
+    _txPartialWrites = 0;
+    return true;
+}
+
+void SparkFun_ublox_Cellular::disableTxQueue(void)
+{
+    if (nullptr != _txQueue)
+    {
+        if ((!txFlush(UBX_CELL_SOCKET_WRITE_TIMEOUT)) && (_printDebug == true))
+            _debugPort->println(F("disableTxQueue: flush timed out. Queued data has been lost"));
+        delete[] _txQueue;
+        _txQueue = nullptr;
+    }
+    _txQueueSize = 0;
+    _txQueueHead = 0;
+    _txQueueTail = 0;
+    _txQueueUsed = 0;
+}
+
+size_t SparkFun_ublox_Cellular::txQueued(void)
+{
+    return (size_t)_txQueueUsed;
+}
+
+size_t SparkFun_ublox_Cellular::txFree(void)
+{
+    return (size_t)(_txQueueSize - _txQueueUsed);
+}
+
+bool SparkFun_ublox_Cellular::txFlush(unsigned long timeout)
+{
+    unsigned long timeIn = millis();
+
+    while ((_txQueueUsed > 0) && ((millis() - timeIn) < timeout))
+    {
+        if (txDrain() > 0)
+            timeIn = millis(); // Still moving
+        else
+            yield();
+    }
+
+    return (_txQueueUsed == 0);
+}
+
+bool SparkFun_ublox_Cellular::enableRxFeed(void (*waitFn)(unsigned long maxMillis), void (*notifyFn)(void),
+                                           size_t size)
+{
+    if ((size < 2) || (size > 32768))
+        return false;
+
+    disableRxFeed();
+
+    _rxFeed = new char[size];
+    if (nullptr == _rxFeed)
+    {
+        if (_printDebug == true)
+            _debugPort->println(F("enableRxFeed: not enough memory for _rxFeed!"));
+        return false;
+    }
+
+    _rxFeedSize = (uint16_t)size;
+    _rxFeedHead = 0;
+    _rxFeedTail = 0;
+    _rxFeedOverruns = 0;
+    _rxWaitCallback = waitFn;
+    _rxNotifyCallback = notifyFn;
+    return true;
+}
+
+void SparkFun_ublox_Cellular::disableRxFeed(void)
+{
+    if (nullptr != _rxFeed)
+    {
+        delete[] _rxFeed;
+        _rxFeed = nullptr;
+    }
+    _rxFeedSize = 0;
+    _rxWaitCallback = nullptr;
+    _rxNotifyCallback = nullptr;
+}
+
+// Called by the producer: the UART RX ISR, or a reader thread
+size_t SparkFun_ublox_Cellular::feedRx(const char *data, size_t len)
+{
+    if ((nullptr == _rxFeed) || (nullptr == data))
+        return 0;
+
+    uint16_t head = _rxFeedHead;
+    uint16_t tail = __atomic_load_n(&_rxFeedTail, __ATOMIC_ACQUIRE);
+    char wakeResponse = _rxWakeResponse;
+    char wakeError = _rxWakeError;
+    bool wake = false;
+    size_t numFed = 0;
+
+    while (numFed < len)
+    {
+        uint16_t next = head + 1;
+        if (next == _rxFeedSize)
+            next = 0;
+        if (next == tail) // Full
+        {
+            _rxFeedOverruns += len - numFed;
+            wake = true;
+            break;
+        }
+        char c = data[numFed++];
+        _rxFeed[head] = c;
+        head = next;
+        if ((c == wakeResponse) || (c == wakeError))
+            wake = true;
+    }
+
+    __atomic_store_n(&_rxFeedHead, head, __ATOMIC_RELEASE);
+
+    uint16_t used = (head >= tail) ? (head - tail) : (_rxFeedSize - tail + head);
+    if (used >= ((_rxFeedSize / 4) * 3))
+        wake = true;
+
+    if ((wake) && (nullptr != _rxNotifyCallback))
+        _rxNotifyCallback();
+
+    return numFed;
+}
+
 // This function was originally written by Matthew Menze for the LTE Shield (SARA-R4) library
 // See: https://github.com/sparkfun/SparkFun_LTE_Shield_Arduino_Library/pull/8
 // It does the same job as ::poll but also processed any 'old' data stored in the backlog first
@@ -221,33 +427,31 @@ bool SparkFun_ublox_Cellular::bufferedPoll(void)
 
     _bufferedPollReentrant = true;
 
-    int avail = 0;
-    char c = 0;
+    txDrain(); // Send any queued data the link will now accept
+    commandService();  // Advance any asynchronous command. URCs which arrive meanwhile are indexed in the ring
+    commandCallback(); // And call back any which completed while a blocking command waited for it
+    if (_asyncHandle == UBX_CELL_COMMAND_HANDLE_INVALID)
+        socketWriteService(); // Send any socket write buffers which are due
+
     bool handled = false;
     unsigned long timeIn = millis();
     char *event;
-    int backlogLen = _saraResponseBacklogLength;
+    int backlogLen = _rxEventCount;
 
-    memset(_saraRXBuffer, 0, _RXBuffSize); // Clear _saraRXBuffer
-
-    // Does the backlog contain any data? If it does, copy it into _saraRXBuffer and then clear the backlog
-    if (_saraResponseBacklogLength > 0)
+    // Does the backlog contain any events? They are already in the ring, ahead of any new serial data
+    if (backlogLen > 0)
     {
         // The backlog also logs reads from other tasks like transmitting.
         if (_printDebug == true)
         {
             _debugPort->print(F("bufferedPoll: backlog found! backlogLen is "));
-            _debugPort->println(_saraResponseBacklogLength);
+            _debugPort->println(_rxRingUsed);
         }
-        memcpy(_saraRXBuffer + avail, _saraResponseBacklog, _saraResponseBacklogLength);
-        avail += _saraResponseBacklogLength;
-        memset(_saraResponseBacklog, 0, _RXBuffSize); // Clear the backlog making sure it is NULL-terminated
-        _saraResponseBacklogLength = 0;
     }
 
     if ((hwAvailable() > 0) || (backlogLen > 0)) // If either new data is available, or backlog had data.
     {
-        // Check for incoming serial data. Copy it into the backlog
+        // Check for incoming serial data. Copy it into the ring
 
         // Important note:
         // On ESP32, Serial.available only provides an update every ~120 bytes during the reception of long messages:
@@ -256,18 +460,13 @@ bool SparkFun_ublox_Cellular::bufferedPoll(void)
         // millis. At 115200 baud, hwAvailable takes ~120 * 10 / 115200 = 10.4 millis before it indicates that data is
         // being received.
 
-        while (((millis() - timeIn) < _rxWindowMillis) && (avail < _RXBuffSize))
+        // While an asynchronous command is in progress, commandService reads the serial data: the response is its
+        while (((millis() - timeIn) < _rxWindowMillis) && (_rxRingUsed < _RXBuffSize) &&
+               (_asyncHandle == UBX_CELL_COMMAND_HANDLE_INVALID))
         {
-            if (hwAvailable() > 0) // hwAvailable can return -1 if the serial port is NULL
+            // Drain everything that is available in one go, straight into the ring. Only the new bytes are indexed
+            if (rxRingFill() > 0)
             {
-                c = readChar();
-                // bufferedPoll is only interested in the URCs.
-                // The URCs are all readable.
-                // strtok does not like NULL characters.
-                // So we need to make sure no NULL characters are added to _saraRXBuffer
-                if (c == '\0')
-                    c = '0'; // Convert any NULLs to ASCII Zeros
-                _saraRXBuffer[avail++] = c;
                 timeIn = millis();
             }
             else
@@ -276,26 +475,27 @@ bool SparkFun_ublox_Cellular::bufferedPoll(void)
             }
         }
 
-        // _saraRXBuffer now contains the backlog (if any) and the new serial data (if any)
-
-        // A health warning about strtok:
-        // strtok will convert any delimiters it finds ("\r\n" in our case) into NULL characters.
-        // Also, be very careful that you do not use strtok within an strtok while loop.
-        // The next call of strtok(NULL, ...) in the outer loop will use the pointer saved from the inner loop!
-        // In our case, strtok is also used in pruneBacklog, which is called by waitForRespone or
-        // sendCommandWithResponse, which is called by the parse functions called by processURCEvent... The solution is
-        // to use strtok_r - the reentrant version of strtok
+        // The ring now contains the backlog (if any) and the new serial data (if any).
+        // Everything indexed so far is about to be processed, so must not be pruned by any commands the URC handlers
+        // send. Events those commands add to the backlog are indexed behind these and are processed in turn.
+        // A partial line (no \r\n yet) stays in the ring until the rest of it arrives.
+        _rxEventKept = _rxEventCount;
 
-        char *preservedEvent;
-        event = strtok_r(_saraRXBuffer, "\r\n",
-                         &preservedEvent); // Look for an 'event' (_saraRXBuffer contains something ending in \r\n)
-
-        if (event != nullptr)
+        if (_rxEventCount > 0)
             if (_printDebug == true)
                 _debugPort->println(F("bufferedPoll: event(s) found! ===>"));
 
-        while (event != nullptr) // Keep going until all events have been processed
+        while (_rxEventCount > 0) // Keep going until all events have been processed
         {
+            if (_rxEvents[_rxEventFirst].type != UBX_CELL_RX_EVENT_LINE) // Prompts and payloads are not URCs
+            {
+                rxRingPop();
+                continue;
+            }
+
+            event = rxRingFront();
+            int eventsAfter = _rxEventCount - 1;
+
             if (_printDebug == true)
             {
                 _debugPort->print(F("bufferedPoll: start of event: "));
@@ -303,7 +503,7 @@ bool SparkFun_ublox_Cellular::bufferedPoll(void)
             }
 
             // Process the event
-            bool latestHandled = processURCEvent((const char *)event);
+            bool latestHandled = processURCLines(event);
             if (latestHandled)
             {
                 if ((true == _printAtDebug) && (nullptr != event))
@@ -312,26 +512,21 @@ bool SparkFun_ublox_Cellular::bufferedPoll(void)
                 }
                 handled = true; // handled will be true if latestHandled has ever been true
             }
-            if ((_saraResponseBacklogLength > 0) &&
-                ((avail + _saraResponseBacklogLength) < _RXBuffSize)) // Has any new data been added to the backlog?
+            if (_rxEventCount - 1 > eventsAfter) // Has any new data been added to the backlog?
             {
                 if (_printDebug == true)
                 {
                     _debugPort->println(F("bufferedPoll: new backlog added!"));
                 }
-                memcpy(_saraRXBuffer + avail, _saraResponseBacklog, _saraResponseBacklogLength);
-                avail += _saraResponseBacklogLength;
-                memset(_saraResponseBacklog, 0, _RXBuffSize); // Clear out the backlog buffer again.
-                _saraResponseBacklogLength = 0;
             }
 
             // Walk through any remaining events
-            event = strtok_r(nullptr, "\r\n", &preservedEvent);
+            rxRingPop();
 
             if (_printDebug == true)
                 _debugPort->println(F("bufferedPoll: end of event")); // Just to denote end of processing event.
 
-            if (event == nullptr)
+            if (_rxEventCount == 0)
                 if (_printDebug == true)
                     _debugPort->println(F("bufferedPoll: <=== end of event(s)!"));
         }
@@ -345,36 +540,34 @@ bool SparkFun_ublox_Cellular::bufferedPoll(void)
 bool SparkFun_ublox_Cellular::urcHandlerReadSocket(const char *event)
 {
     // URC: +UUSORD (Read Socket Data)
-    int socket, length;
-    char *searchPtr = strnstr(event, UBX_CELL_READ_SOCKET_URC, _RXBuffSize);
-    if (searchPtr != nullptr)
+    int socket = -1;
+    int length = 0;
+    SparkFun_ublox_Cellular_Parser parser(event);
+    parser.find(UBX_CELL_READ_SOCKET_URC).integer(socket).integer(length);
+    if (parser.count() == 2)
     {
-        searchPtr += strlen(UBX_CELL_READ_SOCKET_URC); // Move searchPtr to first character - probably a space
-        while (*searchPtr == ' ')
-            searchPtr++; // Skip spaces
-        int ret = sscanf(searchPtr, "%d,%d", &socket, &length);
-        if (ret == 2)
+        if (_printDebug == true)
+            _debugPort->println(F("processReadEvent: read socket data"));
+        // From the UBX_CELL AT Commands Manual:
+        // "For the UDP socket type the URC +UUSORD: <socket>,<length> notifies that a UDP packet has been received,
+        //  either when buffer is empty or after a UDP packet has been read and one or more packets are stored in
+        //  the buffer."
+        // So we need to check if this is a TCP socket or a UDP socket:
+        //  If UDP, we call parseSocketReadIndicationUDP.
+        //  Otherwise, we call parseSocketReadIndication.
+        // Unless the socket belongs to a client, which reads the data into its own buffer
+        if ((socket >= 0) && (socket < UBX_CELL_NUM_SOCKETS) && (_socketClients[socket] != nullptr))
+            _socketClients[socket]->dataAvailable(length);
+        else if ((socket >= 0) && (socket < UBX_CELL_NUM_SOCKETS) && (_lastSocketProtocol[socket] == UBX_CELL_UDP))
         {
             if (_printDebug == true)
-                _debugPort->println(F("processReadEvent: read socket data"));
-            // From the UBX_CELL AT Commands Manual:
-            // "For the UDP socket type the URC +UUSORD: <socket>,<length> notifies that a UDP packet has been received,
-            //  either when buffer is empty or after a UDP packet has been read and one or more packets are stored in
-            //  the buffer."
-            // So we need to check if this is a TCP socket or a UDP socket:
-            //  If UDP, we call parseSocketReadIndicationUDP.
-            //  Otherwise, we call parseSocketReadIndication.
-            if (_lastSocketProtocol[socket] == UBX_CELL_UDP)
-            {
-                if (_printDebug == true)
-                    _debugPort->println(F(
-                        "processReadEvent: received +UUSORD but socket is UDP. Calling parseSocketReadIndicationUDP"));
-                parseSocketReadIndicationUDP(socket, length);
-            }
-            else
-                parseSocketReadIndication(socket, length);
-            return true;
+                _debugPort->println(
+                    F("processReadEvent: received +UUSORD but socket is UDP. Calling parseSocketReadIndicationUDP"));
+            parseSocketReadIndicationUDP(socket, length);
         }
+        else
+            parseSocketReadIndication(socket, length);
+        return true;
     }
 
     return false;
@@ -383,21 +576,16 @@ bool SparkFun_ublox_Cellular::urcHandlerReadSocket(const char *event)
 bool SparkFun_ublox_Cellular::urcHandlerReadUDPSocket(const char *event)
 {
     // URC: +UUSORF (Receive From command (UDP only))
-    int socket, length;
-    char *searchPtr = strnstr(event, UBX_CELL_READ_UDP_SOCKET_URC, _RXBuffSize);
-    if (searchPtr != nullptr)
+    int socket = -1;
+    int length = 0;
+    SparkFun_ublox_Cellular_Parser parser(event);
+    parser.find(UBX_CELL_READ_UDP_SOCKET_URC).integer(socket).integer(length);
+    if (parser.count() == 2)
     {
-        searchPtr += strlen(UBX_CELL_READ_UDP_SOCKET_URC); // Move searchPtr to first character - probably a space
-        while (*searchPtr == ' ')
-            searchPtr++; // skip spaces
-        int ret = sscanf(searchPtr, "%d,%d", &socket, &length);
-        if (ret == 2)
-        {
-            if (_printDebug == true)
-                _debugPort->println(F("processReadEvent: UDP receive"));
-            parseSocketReadIndicationUDP(socket, length);
-            return true;
-        }
+        if (_printDebug == true)
+            _debugPort->println(F("processReadEvent: UDP receive"));
+        parseSocketReadIndicationUDP(socket, length);
+        return true;
     }
 
     return false;
@@ -412,32 +600,17 @@ bool SparkFun_ublox_Cellular::urcHandlerListeningSocket(const char *event)
     unsigned int listenPort = 0;
     IPAddress remoteIP = {0, 0, 0, 0};
     IPAddress localIP = {0, 0, 0, 0};
-    int remoteIPstore[4] = {0, 0, 0, 0};
-    int localIPstore[4] = {0, 0, 0, 0};
 
-    char *searchPtr = strnstr(event, UBX_CELL_LISTEN_SOCKET_URC, _RXBuffSize);
-    if (searchPtr != nullptr)
+    // +UUSOLI: <socket>,"<ip_address>",<port>,<listening_socket>,"<local_ip_address>",<listening_port>
+    SparkFun_ublox_Cellular_Parser parser(event);
+    parser.find(UBX_CELL_LISTEN_SOCKET_URC).integer(socket).ipAddress(remoteIP).integer(port).integer(listenSocket);
+    parser.ipAddress(localIP).integer(listenPort);
+    if (parser.count() >= 2)
     {
-        searchPtr += strlen(UBX_CELL_LISTEN_SOCKET_URC); // Move searchPtr to first character - probably a space
-        while (*searchPtr == ' ')
-            searchPtr++; // skip spaces
-        int ret = sscanf(searchPtr, "%d,\"%d.%d.%d.%d\",%u,%d,\"%d.%d.%d.%d\",%u", &socket, &remoteIPstore[0],
-                         &remoteIPstore[1], &remoteIPstore[2], &remoteIPstore[3], &port, &listenSocket,
-                         &localIPstore[0], &localIPstore[1], &localIPstore[2], &localIPstore[3], &listenPort);
-        for (int i = 0; i <= 3; i++)
-        {
-            if (ret >= 5)
-                remoteIP[i] = (uint8_t)remoteIPstore[i];
-            if (ret >= 11)
-                localIP[i] = (uint8_t)localIPstore[i];
-        }
-        if (ret >= 5)
-        {
-            if (_printDebug == true)
-                _debugPort->println(F("processReadEvent: socket listen"));
-            parseSocketListenIndication(listenSocket, localIP, listenPort, socket, remoteIP, port);
-            return true;
-        }
+        if (_printDebug == true)
+            _debugPort->println(F("processReadEvent: socket listen"));
+        parseSocketListenIndication(listenSocket, localIP, listenPort, socket, remoteIP, port);
+        return true;
     }
 
     return false;
@@ -446,27 +619,24 @@ bool SparkFun_ublox_Cellular::urcHandlerListeningSocket(const char *event)
 bool SparkFun_ublox_Cellular::urcHandlerCloseSocket(const char *event)
 {
     // URC: +UUSOCL (Close Socket)
-    int socket;
-    char *searchPtr = strnstr(event, UBX_CELL_CLOSE_SOCKET_URC, _RXBuffSize);
-    if (searchPtr != nullptr)
+    int socket = -1;
+    SparkFun_ublox_Cellular_Parser parser(event);
+    parser.find(UBX_CELL_CLOSE_SOCKET_URC).integer(socket);
+    if (parser.count() == 1)
     {
-        searchPtr += strlen(UBX_CELL_CLOSE_SOCKET_URC); // Move searchPtr to first character - probably a space
-        while (*searchPtr == ' ')
-            searchPtr++; // skip spaces
-        int ret = sscanf(searchPtr, "%d", &socket);
-        if (ret == 1)
+        if (_printDebug == true)
+            _debugPort->println(F("processReadEvent: socket close"));
+        if ((socket >= 0) && (socket < UBX_CELL_NUM_SOCKETS) && (_socketClients[socket] != nullptr))
+            _socketClients[socket]->remoteClose();
+        freeSocketWriteBuffer(socket); // Anything still buffered can no longer be sent
+        if ((socket >= 0) && (socket <= 6))
         {
-            if (_printDebug == true)
-                _debugPort->println(F("processReadEvent: socket close"));
-            if ((socket >= 0) && (socket <= 6))
+            if (_socketCloseCallback != nullptr)
             {
-                if (_socketCloseCallback != nullptr)
-                {
-                    _socketCloseCallback(socket);
-                }
+                _socketCloseCallback(socket);
             }
-            return true;
         }
+        return true;
     }
 
     return false;
@@ -478,75 +648,67 @@ bool SparkFun_ublox_Cellular::urcHandlerGNSSRequestLocation(const char *event)
     ClockData clck;
     PositionData gps;
     SpeedData spd;
-    unsigned long uncertainty;
-    int scanNum;
-    int latH, lonH, alt;
-    unsigned int speedU, cogU;
-    char latL[10], lonL[10];
-    int dateStore[5];
+    unsigned long uncertainty = 0;
+    double lat = 0.0;
+    double lon = 0.0;
+    int alt = 0;
+    unsigned int speedU = 0;
+    unsigned int cogU = 0;
+    int dateStore[3] = {0, 0, 0};
+    int timeStore[3] = {0, 0, 0};
 
     // Maybe we should also scan for +UUGIND and extract the activated gnss system?
 
     // This assumes the ULOC response type is "0" or "1" - as selected by gpsRequest detailed
-    char *searchPtr = strnstr(event, UBX_CELL_GNSS_REQUEST_LOCATION_URC, _RXBuffSize);
-    if (searchPtr != nullptr)
-    {
-        searchPtr += strlen(UBX_CELL_GNSS_REQUEST_LOCATION_URC); // Move searchPtr to first character - probably a space
-        while (*searchPtr == ' ')
-            searchPtr++; // skip spaces
-        scanNum = sscanf(searchPtr, "%d/%d/%d,%d:%d:%d.%d,%d.%[^,],%d.%[^,],%d,%lu,%u,%u,%*s", &dateStore[0],
-                         &dateStore[1], &clck.date.year, &dateStore[2], &dateStore[3], &dateStore[4], &clck.time.ms,
-                         &latH, latL, &lonH, lonL, &alt, &uncertainty, &speedU, &cogU);
-        clck.date.day = dateStore[0];
-        clck.date.month = dateStore[1];
-        clck.time.hour = dateStore[2];
-        clck.time.minute = dateStore[3];
-        clck.time.second = dateStore[4];
-
-        if (scanNum >= 13)
-        {
-            // Found a Location string!
-            if (_printDebug == true)
-            {
-                _debugPort->println(F("processReadEvent: location"));
-            }
-
-            if (latH >= 0)
-                gps.lat = (float)latH + ((float)atol(latL) / pow(10, strlen(latL)));
-            else
-                gps.lat = (float)latH - ((float)atol(latL) / pow(10, strlen(latL)));
-            if (lonH >= 0)
-                gps.lon = (float)lonH + ((float)atol(lonL) / pow(10, strlen(lonL)));
-            else
-                gps.lon = (float)lonH - ((float)atol(lonL) / pow(10, strlen(lonL)));
-            gps.alt = (float)alt;
-            if (scanNum >= 15) // If detailed response, get speed data
-            {
-                spd.speed = (float)speedU;
-                spd.cog = (float)cogU;
-            }
+    // +UULOC: <date>,<time>,<lat>,<long>,<alt>,<uncertainty>[,<speed>,<direction>,...]
+    SparkFun_ublox_Cellular_Parser parser(event);
+    parser.find(UBX_CELL_GNSS_REQUEST_LOCATION_URC).dotted(dateStore, 3, '/').literal(',').dotted(timeStore, 3, ':');
+    parser.literal('.').integer(clck.time.ms).decimal(lat).decimal(lon).integer(alt).integer(uncertainty);
+    parser.integer(speedU).integer(cogU);
+    clck.date.day = dateStore[0];
+    clck.date.month = dateStore[1];
+    clck.date.year = dateStore[2];
+    clck.time.hour = timeStore[0];
+    clck.time.minute = timeStore[1];
+    clck.time.second = timeStore[2];
+
+    if (parser.count() >= 11) // Everything up to the uncertainty
+    {
+        // Found a Location string!
+        if (_printDebug == true)
+        {
+            _debugPort->println(F("processReadEvent: location"));
+        }
 
-            // if (_printDebug == true)
-            // {
-            //   _debugPort->print(F("processReadEvent: location:  lat: "));
-            //   _debugPort->print(gps.lat, 7);
-            //   _debugPort->print(F(" lon: "));
-            //   _debugPort->print(gps.lon, 7);
-            //   _debugPort->print(F(" alt: "));
-            //   _debugPort->print(gps.alt, 2);
-            //   _debugPort->print(F(" speed: "));
-            //   _debugPort->print(spd.speed, 2);
-            //   _debugPort->print(F(" cog: "));
-            //   _debugPort->println(spd.cog, 2);
-            // }
+        gps.lat = (float)lat;
+        gps.lon = (float)lon;
+        gps.alt = (float)alt;
+        if (parser.count() >= 13) // If detailed response, get speed data
+        {
+            spd.speed = (float)speedU;
+            spd.cog = (float)cogU;
+        }
 
-            if (_gpsRequestCallback != nullptr)
-            {
-                _gpsRequestCallback(clck, gps, spd, uncertainty);
-            }
+        // if (_printDebug == true)
+        // {
+        //   _debugPort->print(F("processReadEvent: location:  lat: "));
+        //   _debugPort->print(gps.lat, 7);
+        //   _debugPort->print(F(" lon: "));
+        //   _debugPort->print(gps.lon, 7);
+        //   _debugPort->print(F(" alt: "));
+        //   _debugPort->print(gps.alt, 2);
+        //   _debugPort->print(F(" speed: "));
+        //   _debugPort->print(spd.speed, 2);
+        //   _debugPort->print(F(" cog: "));
+        //   _debugPort->println(spd.cog, 2);
+        // }
 
-            return true;
+        if (_gpsRequestCallback != nullptr)
+        {
+            _gpsRequestCallback(clck, gps, spd, uncertainty);
         }
+
+        return true;
     }
 
     return false;
@@ -556,31 +718,23 @@ bool SparkFun_ublox_Cellular::urcHandlerSIMState(const char *event)
 {
     // URC: +UUSIMSTAT (SIM Status)
     UBX_CELL_sim_states_t state;
-    int scanNum;
-    int stateStore;
+    int stateStore = 0;
 
-    char *searchPtr = strnstr(event, UBX_CELL_SIM_STATE_URC, _RXBuffSize);
-    if (searchPtr != nullptr)
+    SparkFun_ublox_Cellular_Parser parser(event);
+    parser.find(UBX_CELL_SIM_STATE_URC).integer(stateStore);
+    if (parser.count() == 1)
     {
-        searchPtr += strlen(UBX_CELL_SIM_STATE_URC); // Move searchPtr to first character - probably a space
-        while (*searchPtr == ' ')
-            searchPtr++; // skip spaces
-        scanNum = sscanf(searchPtr, "%d", &stateStore);
-
-        if (scanNum == 1)
-        {
-            if (_printDebug == true)
-                _debugPort->println(F("processReadEvent: SIM status"));
-
-            state = (UBX_CELL_sim_states_t)stateStore;
+        if (_printDebug == true)
+            _debugPort->println(F("processReadEvent: SIM status"));
 
-            if (_simStateReportCallback != nullptr)
-            {
-                _simStateReportCallback(state);
-            }
+        state = (UBX_CELL_sim_states_t)stateStore;
 
-            return true;
+        if (_simStateReportCallback != nullptr)
+        {
+            _simStateReportCallback(state);
         }
+
+        return true;
     }
 
     return false;
@@ -589,32 +743,26 @@ bool SparkFun_ublox_Cellular::urcHandlerSIMState(const char *event)
 bool SparkFun_ublox_Cellular::urcHandlerHTTPCommand(const char *event)
 {
     // URC: +UUHTTPCR (HTTP Command Result)
-    int profile, command, result;
-    int scanNum;
+    int profile = -1;
+    int command = -1;
+    int result = 0;
 
-    char *searchPtr = strnstr(event, UBX_CELL_HTTP_COMMAND_URC, _RXBuffSize);
-    if (searchPtr != nullptr)
+    SparkFun_ublox_Cellular_Parser parser(event);
+    parser.find(UBX_CELL_HTTP_COMMAND_URC).integer(profile).integer(command).integer(result);
+    if (parser.count() == 3)
     {
-        searchPtr += strlen(UBX_CELL_HTTP_COMMAND_URC); // Move searchPtr to first character - probably a space
-        while (*searchPtr == ' ')
-            searchPtr++; // skip spaces
-        scanNum = sscanf(searchPtr, "%d,%d,%d", &profile, &command, &result);
+        if (_printDebug == true)
+            _debugPort->println(F("processReadEvent: HTTP command result"));
 
-        if (scanNum == 3)
+        if ((profile >= 0) && (profile < UBX_CELL_NUM_HTTP_PROFILES))
         {
-            if (_printDebug == true)
-                _debugPort->println(F("processReadEvent: HTTP command result"));
-
-            if ((profile >= 0) && (profile < UBX_CELL_NUM_HTTP_PROFILES))
+            if (_httpCommandRequestCallback != nullptr)
             {
-                if (_httpCommandRequestCallback != nullptr)
-                {
-                    _httpCommandRequestCallback(profile, command, result);
-                }
+                _httpCommandRequestCallback(profile, command, result);
             }
-
-            return true;
         }
+
+        return true;
     }
 
     return false;
@@ -623,41 +771,28 @@ bool SparkFun_ublox_Cellular::urcHandlerHTTPCommand(const char *event)
 bool SparkFun_ublox_Cellular::urcHandlerMQTTCommand(const char *event)
 {
     // URC: +UUMQTTC (MQTT Command Result)
-    int command, result;
-    int scanNum;
+    int command = -1;
+    int result = 0;
     int qos = -1;
     String topic;
 
-    char *searchPtr = strnstr(event, UBX_CELL_MQTT_COMMAND_URC, _RXBuffSize);
-    if (searchPtr != nullptr)
+    SparkFun_ublox_Cellular_Parser parser(event);
+    parser.find(UBX_CELL_MQTT_COMMAND_URC).integer(command).integer(result);
+    if ((parser.count() == 2) && (command == UBX_CELL_MQTT_COMMAND_SUBSCRIBE))
+        parser.integer(qos).quoted(topic);
+    if ((parser.count() == 2) || (parser.count() == 4))
     {
-        searchPtr += strlen(UBX_CELL_MQTT_COMMAND_URC); // Move searchPtr to first character - probably a space
-        while (*searchPtr == ' ')
+        if (_printDebug == true)
         {
-            searchPtr++; // skip spaces
+            _debugPort->println(F("processReadEvent: MQTT command result"));
         }
 
-        scanNum = sscanf(searchPtr, "%d,%d", &command, &result);
-        if ((scanNum == 2) && (command == UBX_CELL_MQTT_COMMAND_SUBSCRIBE))
+        if (_mqttCommandRequestCallback != nullptr)
         {
-            char topicC[100] = "";
-            scanNum = sscanf(searchPtr, "%*d,%*d,%d,\"%[^\"]\"", &qos, topicC);
-            topic = topicC;
+            _mqttCommandRequestCallback(command, result);
         }
-        if ((scanNum == 2) || (scanNum == 4))
-        {
-            if (_printDebug == true)
-            {
-                _debugPort->println(F("processReadEvent: MQTT command result"));
-            }
-
-            if (_mqttCommandRequestCallback != nullptr)
-            {
-                _mqttCommandRequestCallback(command, result);
-            }
 
-            return true;
-        }
+        return true;
     }
 
     return false;
@@ -672,96 +807,49 @@ bool SparkFun_ublox_Cellular::urcHandlerPingCommand(const char *event)
     String remote_host = "";
     IPAddress remoteIP = {0, 0, 0, 0};
     long rtt = 0;
-    int scanNum;
 
-    // Try to extract the UUPING retries and payload size
-    char *searchPtr = strnstr(event, UBX_CELL_PING_COMMAND_URC, _RXBuffSize);
-    if (searchPtr != nullptr)
+    // +UUPING: <retry_num>,<p_size>,"<remote_hostname>","<remote_ip>",<ttl>,<rtt>
+    SparkFun_ublox_Cellular_Parser parser(event);
+    parser.find(UBX_CELL_PING_COMMAND_URC).integer(retry).integer(p_size);
+    if (parser.count() == 2)
     {
-        searchPtr += strlen(UBX_CELL_PING_COMMAND_URC); // Move searchPtr to first character - probably a space
-        while (*searchPtr == ' ')
-            searchPtr++; // skip spaces
-        scanNum = sscanf(searchPtr, "%d,%d,", &retry, &p_size);
+        if (_printDebug == true)
+        {
+            _debugPort->println(F("processReadEvent: ping"));
+        }
 
-        if (scanNum == 2)
+        parser.quoted(remote_host).ipAddress(remoteIP);
+        if (parser.count() == 4) // Make sure we extracted enough data
         {
-            if (_printDebug == true)
+            // It's possible the TTL is not present (eg. on LARA-R6), so ttl defaults to 0
+            SparkFun_ublox_Cellular_Parser ttlParser(parser.position());
+            ttlParser.literal(',').integer(ttl);
+            parser.skip().integer(rtt);
+            if (parser.count() == 5) // Callback, if it exists
             {
-                _debugPort->println(F("processReadEvent: ping"));
+                if (_pingRequestCallback != nullptr)
+                {
+                    _pingRequestCallback(retry, p_size, remote_host, remoteIP, ttl, rtt);
+                }
             }
+        }
+        return true;
+    }
 
-            searchPtr = strchr(++searchPtr, '\"'); // Search to the first quote
-
-            // Extract the remote host name, stop at the next quote
-            while ((*(++searchPtr) != '\"') && (*searchPtr != '\0'))
-            {
-                remote_host.concat(*(searchPtr));
-            }
-
-            if (*searchPtr != '\0') // Make sure we found a quote
-            {
-                // Extract IP address
-                int remoteIPstore[4];
-                scanNum = sscanf(searchPtr, "\",\"%d.%d.%d.%d", &remoteIPstore[0], &remoteIPstore[1], &remoteIPstore[2],
-                                 &remoteIPstore[3]);
-                for (int i = 0; i <= 3; i++)
-                {
-                    remoteIP[i] = (uint8_t)remoteIPstore[i];
-                }
-
-                if (scanNum == 4) // Make sure we extracted enough data
-                {
-                    // Extract TTL, should be immediately after IP address
-                    searchPtr = strchr(searchPtr + 2, ','); // +2 to skip the quote and comma
-                    if (searchPtr != nullptr)
-                    {
-                        // It's possible the TTL is not present (eg. on LARA-R6), so we
-                        // can ignore scanNum since ttl defaults to 0 anyways
-                        scanNum = sscanf(searchPtr, ",%d", &ttl);
-
-                        // Extract RTT, should be immediately after TTL
-                        searchPtr = strchr(searchPtr + 1, ','); // +1 to skip the comma
-                        if (searchPtr != nullptr)
-                        {
-                            scanNum = sscanf(searchPtr, ",%ld", &rtt);
-
-                            // Callback, if it exists
-                            if (_pingRequestCallback != nullptr)
-                            {
-                                _pingRequestCallback(retry, p_size, remote_host, remoteIP, ttl, rtt);
-                            }
-                        }
-                    }
-                }
-            }
-            return true;
-        }
-    }
-
-    return false;
-}
+    return false;
+}
 
 bool SparkFun_ublox_Cellular::urcHandlerFTPCommand(const char *event)
 {
     // URC: +UUFTPCR (FTP Command Result)
-    int ftpCmd;
-    int ftpResult;
-    int scanNum;
-    char *searchPtr = strnstr(event, UBX_CELL_FTP_COMMAND_URC, _RXBuffSize);
-    if (searchPtr != nullptr)
+    int ftpCmd = -1;
+    int ftpResult = 0;
+    SparkFun_ublox_Cellular_Parser parser(event);
+    parser.find(UBX_CELL_FTP_COMMAND_URC).integer(ftpCmd).integer(ftpResult);
+    if (parser.count() == 2 && _ftpCommandRequestCallback != nullptr)
     {
-        searchPtr += strlen(UBX_CELL_FTP_COMMAND_URC); // Move searchPtr to first character - probably a space
-        while (*searchPtr == ' ')
-        {
-            searchPtr++; // skip spaces
-        }
-
-        scanNum = sscanf(searchPtr, "%d,%d", &ftpCmd, &ftpResult);
-        if (scanNum == 2 && _ftpCommandRequestCallback != nullptr)
-        {
-            _ftpCommandRequestCallback(ftpCmd, ftpResult);
-            return true;
-        }
+        _ftpCommandRequestCallback(ftpCmd, ftpResult);
+        return true;
     }
 
     return false;
@@ -772,25 +860,19 @@ bool SparkFun_ublox_Cellular::urcHandlerRegistrationStatus(const char *event)
     // URC: +CREG
     int status = 0;
     unsigned int lac = 0, ci = 0, Act = 0;
-    char *searchPtr = strnstr(event, UBX_CELL_REGISTRATION_STATUS_URC, _RXBuffSize);
-    if (searchPtr != nullptr)
+    SparkFun_ublox_Cellular_Parser parser(event);
+    parser.find(UBX_CELL_REGISTRATION_STATUS_URC).integer(status).hex(lac).hex(ci).integer(Act);
+    if (parser.count() == 4)
     {
-        searchPtr += strlen(UBX_CELL_REGISTRATION_STATUS_URC); // Move searchPtr to first character - probably a space
-        while (*searchPtr == ' ')
-            searchPtr++; // skip spaces
-        int scanNum = sscanf(searchPtr, "%d,\"%4x\",\"%4x\",%d", &status, &lac, &ci, &Act);
-        if (scanNum == 4)
-        {
-            if (_printDebug == true)
-                _debugPort->println(F("processReadEvent: CREG"));
-
-            if (_registrationCallback != nullptr)
-            {
-                _registrationCallback((UBX_CELL_registration_status_t)status, lac, ci, Act);
-            }
+        if (_printDebug == true)
+            _debugPort->println(F("processReadEvent: CREG"));
 
-            return true;
+        if (_registrationCallback != nullptr)
+        {
+            _registrationCallback((UBX_CELL_registration_status_t)status, lac, ci, Act);
         }
+
+        return true;
     }
 
     return false;
@@ -801,26 +883,19 @@ bool SparkFun_ublox_Cellular::urcHandlerEPSRegistrationStatus(const char *event)
     // URC: +CEREG
     int status = 0;
     unsigned int tac = 0, ci = 0, Act = 0;
-    char *searchPtr = strnstr(event, UBX_CELL_EPSREGISTRATION_STATUS_URC, _RXBuffSize);
-    if (searchPtr != nullptr)
+    SparkFun_ublox_Cellular_Parser parser(event);
+    parser.find(UBX_CELL_EPSREGISTRATION_STATUS_URC).integer(status).hex(tac).hex(ci).integer(Act);
+    if (parser.count() == 4)
     {
-        searchPtr +=
-            strlen(UBX_CELL_EPSREGISTRATION_STATUS_URC); // Move searchPtr to first character - probably a space
-        while (*searchPtr == ' ')
-            searchPtr++; // skip spaces
-        int scanNum = sscanf(searchPtr, "%d,\"%4x\",\"%4x\",%d", &status, &tac, &ci, &Act);
-        if (scanNum == 4)
-        {
-            if (_printDebug == true)
-                _debugPort->println(F("processReadEvent: CEREG"));
-
-            if (_epsRegistrationCallback != nullptr)
-            {
-                _epsRegistrationCallback((UBX_CELL_registration_status_t)status, tac, ci, Act);
-            }
+        if (_printDebug == true)
+            _debugPort->println(F("processReadEvent: CEREG"));
 
-            return true;
+        if (_epsRegistrationCallback != nullptr)
+        {
+            _epsRegistrationCallback((UBX_CELL_registration_status_t)status, tac, ci, Act);
         }
+
+        return true;
     }
 
     return false;
@@ -828,20 +903,98 @@ bool SparkFun_ublox_Cellular::urcHandlerEPSRegistrationStatus(const char *event)
 
 void SparkFun_ublox_Cellular::addURCHandler(const char *urcString, UBX_CELL_urc_handler_t urcHandler)
 {
+    int16_t handler = (int16_t)_urcHandlers.size();
     _urcStrings.push_back(urcString);
     _urcHandlers.push_back(urcHandler);
+    _urcNextHandler.push_back(-1);
+
+    // Add urcString to the index, one node per character
+    if (_urcIndex.empty())
+        _urcIndex.push_back({'\0', -1, -1, -1}); // The root
+
+    int node = 0;
+    for (const char *c = urcString; *c != '\0'; c++)
+    {
+        int16_t next = _urcIndex[node].child;
+        while ((next >= 0) && (_urcIndex[next].c != *c))
+            next = _urcIndex[next].sibling;
+        if (next < 0)
+        {
+            next = (int16_t)_urcIndex.size();
+            _urcIndex.push_back({*c, -1, _urcIndex[node].child, -1});
+            _urcIndex[node].child = next;
+        }
+        node = next;
+    }
+
+    // Handlers for the same URC are called in the order they were added
+    if (_urcIndex[node].handler < 0)
+    {
+        _urcIndex[node].handler = handler;
+    }
+    else
+    {
+        int16_t last = _urcIndex[node].handler;
+        while (_urcNextHandler[last] >= 0)
+            last = _urcNextHandler[last];
+        _urcNextHandler[last] = handler;
+    }
 }
 
 // Parse incoming URC's - the associated parse functions pass the data to the user via the callbacks (if defined)
 bool SparkFun_ublox_Cellular::processURCEvent(const char *event)
 {
-    // Iterate through each URC handler to see if it can handle this message
-    for (auto urcHandler : _urcHandlers)
+    // Only the handlers for the URCs which the event contains are called
+    int length = (int)strlen(event);
+    return urcIndexSearch(event, length, 0, length, event);
+}
+
+// Process an event from the ring one line at a time. It holds several URC lines if rxRingMergeEvents merged them.
+// Each line is NUL-terminated in place while its handlers run, then its delimiter is put back
+bool SparkFun_ublox_Cellular::processURCLines(char *event)
+{
+    bool handled = false;
+
+    while (*event != '\0')
+    {
+        char *end = event + strcspn(event, "\r\n");
+        char delimiter = *end;
+        *end = '\0';
+        if (end > event)
+            handled |= processURCEvent(event);
+        *end = delimiter;
+        event = (delimiter == '\0') ? end : end + 1;
+    }
+
+    return handled;
+}
+
+bool SparkFun_ublox_Cellular::urcIndexSearch(const char *buf, int bufSize, int start, int length, const char *event)
+{
+    if (_urcIndex.empty())
+        return false;
+
+    // URCs are normally at the start of the event. Start further in only where the first character could match
+    for (int p = 0; p < length; p++)
     {
-        if (urcHandler(event))
+        int16_t node = _urcIndex[0].child;
+        for (int i = p; (i < length) && (node >= 0); i++)
         {
-            // This handler took care of it, so we're done!
-            return true;
+            char c = buf[(start + i) % bufSize];
+            while ((node >= 0) && (_urcIndex[node].c != c))
+                node = _urcIndex[node].sibling;
+            if (node < 0)
+                break;
+
+            for (int16_t handler = _urcIndex[node].handler; handler >= 0; handler = _urcNextHandler[handler])
+            {
+                if (event == nullptr)
+                    return true;
+                if (_urcHandlers[handler](event))
+                    return true; // This handler took care of it, so we're done!
+            }
+
+            node = _urcIndex[node].child;
         }
     }
 
@@ -852,6 +1005,7 @@ bool SparkFun_ublox_Cellular::processURCEvent(const char *event)
 // This is the original poll function.
 // It is 'blocking' - it does not return when serial data is available until it receives a `\n`.
 // ::bufferedPoll is the new improved version. It processes any data in the backlog and includes a timeout.
+// Note: poll and bufferedPoll share the RX ring. So poll will also process any events waiting in the backlog.
 bool SparkFun_ublox_Cellular::poll(void)
 {
     if (_pollReentrant == true) // Check for reentry (i.e. poll has been called from inside a callback)
@@ -859,20 +1013,27 @@ bool SparkFun_ublox_Cellular::poll(void)
 
     _pollReentrant = true;
 
-    int avail = 0;
     char c = 0;
     bool handled = false;
 
-    memset(_saraRXBuffer, 0, _RXBuffSize); // Clear _saraRXBuffer
+    // Advance any asynchronous command. It reads the serial data itself, indexing any URCs in the ring.
+    // A callback may have sent the next command, so check again afterwards
+    commandService();
+    commandCallback();
+    bool asyncIdle = (_asyncHandle == UBX_CELL_COMMAND_HANDLE_INVALID);
+    if (!asyncIdle)
+        c = '\n'; // Leave the serial data to the command
+    else
+        socketWriteService(); // Send any socket write buffers which are due
 
-    if (hwAvailable() > 0) // hwAvailable can return -1 if the serial port is NULL
+    if ((hwAvailable() > 0) || (!asyncIdle)) // hwAvailable can return -1 if the serial port is NULL
     {
-        while (c != '\n') // Copy characters into _saraRXBuffer. Stop at the first new line
+        while (c != '\n') // Copy characters into the ring. Stop at the first new line
         {
-            if (hwAvailable() > 0) // hwAvailable can return -1 if the serial port is NULL
+            if (rxFill() > 0)
             {
-                c = readChar();
-                _saraRXBuffer[avail++] = c;
+                c = _rxStage[_rxStageHead++];
+                rxRingPut(c);
             }
             else
             {
@@ -881,18 +1042,31 @@ bool SparkFun_ublox_Cellular::poll(void)
         }
 
         // Now search for all supported URC's
-        handled = processURCEvent(_saraRXBuffer);
-        if (handled && (true == _printAtDebug))
-        {
-            _debugAtPort->write(_saraRXBuffer, avail);
-        }
-        if ((handled == false) && (strlen(_saraRXBuffer) > 2))
+        _rxEventKept = _rxEventCount; // Protect these events from any commands sent by the URC handlers
+        while (_rxEventCount > 0)
         {
-            if (_printDebug == true)
+            if (_rxEvents[_rxEventFirst].type != UBX_CELL_RX_EVENT_LINE) // Prompts and payloads are not URCs
             {
-                _debugPort->print(F("poll: "));
-                _debugPort->println(_saraRXBuffer);
+                rxRingPop();
+                continue;
+            }
+
+            char *event = rxRingFront();
+            bool latestHandled = processURCLines(event);
+            if (latestHandled && (true == _printAtDebug))
+            {
+                _debugAtPort->print(event);
+            }
+            if (latestHandled == false)
+            {
+                if (_printDebug == true)
+                {
+                    _debugPort->print(F("poll: "));
+                    _debugPort->println(event);
+                }
             }
+            handled |= latestHandled;
+            rxRingPop();
         }
     }
 
@@ -1351,17 +1525,15 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::setClock(uint8_t y, uint8_t mo, uint8_
 UBX_CELL_error_t SparkFun_ublox_Cellular::setClock(String theTime)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_COMMAND_CLOCK) + theTime.length() + 8;
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_COMMAND_CLOCK).quoted(theTime);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=\"%s\"", UBX_CELL_COMMAND_CLOCK, theTime.c_str());
 
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
 
-    free(command);
     return err;
 }
 
@@ -1538,8 +1710,7 @@ mobile_network_operator_t SparkFun_ublox_Cellular::getNetworkProfile(void)
 UBX_CELL_error_t SparkFun_ublox_Cellular::setAPN(String apn, uint8_t cid, UBX_CELL_pdp_type pdpType)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_MESSAGE_PDP_DEF) + strlen(apn.c_str()) + 16;
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
     char pdpStr[8];
 
     memset(pdpStr, 0, 8);
@@ -1547,13 +1718,9 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::setAPN(String apn, uint8_t cid, UBX_CE
     if (cid >= 8)
         return UBX_CELL_ERROR_UNEXPECTED_PARAM;
 
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
-        return UBX_CELL_ERROR_OUT_OF_MEMORY;
     switch (pdpType)
     {
     case PDP_TYPE_INVALID:
-        free(command);
         return UBX_CELL_ERROR_UNEXPECTED_PARAM;
         break;
     case PDP_TYPE_IP:
@@ -1569,15 +1736,15 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::setAPN(String apn, uint8_t cid, UBX_CE
         memcpy(pdpStr, "IPV6", 4);
         break;
     default:
-        free(command);
         return UBX_CELL_ERROR_UNEXPECTED_PARAM;
         break;
     }
+    command.begin(UBX_CELL_MESSAGE_PDP_DEF).arg(cid).quoted(pdpStr);
     if (apn == nullptr)
     {
         if (_printDebug == true)
             _debugPort->println(F("setAPN: nullptr"));
-        snprintf(command, cmdLen, "%s=%d,\"%s\",\"\"", UBX_CELL_MESSAGE_PDP_DEF, cid, pdpStr);
+        command.quoted("");
     }
     else
     {
@@ -1586,12 +1753,13 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::setAPN(String apn, uint8_t cid, UBX_CE
             _debugPort->print(F("setAPN: "));
             _debugPort->println(apn);
         }
-        snprintf(command, cmdLen, "%s=%d,\"%s\",\"%s\"", UBX_CELL_MESSAGE_PDP_DEF, cid, pdpStr, apn.c_str());
+        command.quoted(apn);
     }
+    if (command.overflow())
+        return UBX_CELL_ERROR_OUT_OF_MEMORY;
 
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
-
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
 
     return err;
 }
@@ -1602,11 +1770,15 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getAPN(int cid, String *apn, IPAddress
     UBX_CELL_error_t err;
     size_t cmdLen = strlen(UBX_CELL_MESSAGE_PDP_DEF) + 3;
     char command[cmdLen];
-    char response[1024];
 
     if (cid > UBX_CELL_NUM_PDP_CONTEXT_IDENTIFIERS)
         return UBX_CELL_ERROR_ERROR;
 
+    size_t arenaMark = _arena.mark();
+    char *response = responseAlloc(1024);
+    if (response == nullptr)
+        return UBX_CELL_ERROR_OUT_OF_MEMORY;
+
     snprintf(command, cmdLen, "%s?", UBX_CELL_MESSAGE_PDP_DEF);
 
     err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, response, UBX_CELL_STANDARD_RESPONSE_TIMEOUT,
@@ -1672,6 +1844,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getAPN(int cid, String *apn, IPAddress
         err = UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
     }
 
+    responseRelease(response, arenaMark);
     return err;
 }
 
@@ -1712,15 +1885,13 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getSimStatus(String *code)
 UBX_CELL_error_t SparkFun_ublox_Cellular::setSimPin(String pin)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_COMMAND_SIMPIN) + 4 + pin.length();
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_COMMAND_SIMPIN).quoted(pin);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=\"%s\"", UBX_CELL_COMMAND_SIMPIN, pin.c_str());
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
@@ -1814,7 +1985,8 @@ uint8_t SparkFun_ublox_Cellular::getOperators(struct operator_stats *opRet, int
     snprintf(command, cmdLen, "%s=?", UBX_CELL_OPERATOR_SELECTION);
 
     int responseSize = (maxOps + 1) * 48;
-    response = ubx_cell_calloc_char(responseSize);
+    size_t arenaMark = _arena.mark();
+    response = responseAlloc(responseSize);
     if (response == nullptr)
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
 
@@ -1822,11 +1994,6 @@ uint8_t SparkFun_ublox_Cellular::getOperators(struct operator_stats *opRet, int
     err =
         sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, response, UBX_CELL_3_MIN_TIMEOUT, responseSize);
 
-    // Sample responses:
-    // +COPS: (3,"Verizon Wireless","VzW","311480",8),,(0,1,2,3,4),(0,1,2)
-    // +COPS: (1,"313 100","313 100","313100",8),(2,"AT&T","AT&T","310410",8),(3,"311 480","311
-    // 480","311480",8),,(0,1,2,3,4),(0,1,2)
-
     if (_printDebug == true)
     {
         _debugPort->print(F("getOperators: Response: {"));
@@ -1835,49 +2002,98 @@ uint8_t SparkFun_ublox_Cellular::getOperators(struct operator_stats *opRet, int
     }
 
     if (err == UBX_CELL_ERROR_SUCCESS)
+        opsSeen = parseOperators(response, opRet, maxOps);
+
+    responseRelease(response, arenaMark);
+
+    return opsSeen;
+}
+
+UBX_CELL_command_handle_t SparkFun_ublox_Cellular::getOperatorsAsync(struct operator_stats *opRet, int maxOps,
+                                                                     UBX_CELL_operators_callback_t callback)
+{
+    size_t cmdLen = strlen(UBX_CELL_OPERATOR_SELECTION) + 3;
+    char command[cmdLen];
+    UBX_CELL_command_handle_t handle;
+
+    if ((opRet == nullptr) || (maxOps <= 0))
+        return UBX_CELL_COMMAND_HANDLE_INVALID;
+
+    snprintf(command, cmdLen, "%s=?", UBX_CELL_OPERATOR_SELECTION);
+
+    // Not from the arena: the response has to outlive this call, and the arena is released in stack order
+    int responseSize = (maxOps + 1) * 48;
+    char *response = ubx_cell_calloc_char(responseSize);
+    if (response == nullptr)
+    {
+        if (_printDebug == true)
+            _debugPort->println(F("getOperatorsAsync: out of memory"));
+        return UBX_CELL_COMMAND_HANDLE_INVALID;
+    }
+
+    // AT+COPS maximum response time is 3 minutes (180000 ms)
+    handle = sendCommandAsync(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, response, responseSize,
+                              UBX_CELL_3_MIN_TIMEOUT);
+    if (handle == UBX_CELL_COMMAND_HANDLE_INVALID)
     {
-        char *opBegin;
-        char *opEnd;
-        int op = 0;
-        int stat;
-        char longOp[26];
-        char shortOp[11];
-        int act;
-        unsigned long numOp;
+        free(response);
+        return handle;
+    }
 
-        opBegin = response;
+    _asyncOperators = opRet;
+    _asyncMaxOperators = maxOps;
+    _asyncOperatorsResponse = response;
+    _asyncOperatorsCallback = callback;
+    return handle;
+}
 
-        for (; op < maxOps; op++)
-        {
-            opBegin = strchr(opBegin, '(');
-            if (opBegin == nullptr)
-                break;
-            opEnd = strchr(opBegin, ')');
-            if (opEnd == nullptr)
-                break;
+uint8_t SparkFun_ublox_Cellular::parseOperators(const char *response, struct operator_stats *opRet, int maxOps)
+{
+    const char *opBegin;
+    const char *opEnd;
+    int op = 0;
+    int stat;
+    char longOp[26];
+    char shortOp[11];
+    int act;
+    unsigned long numOp;
+    uint8_t opsSeen = 0;
 
-            int sscanRead =
-                sscanf(opBegin, "(%d,\"%[^\"]\",\"%[^\"]\",\"%lu\",%d)%*s", &stat, longOp, shortOp, &numOp, &act);
-            if (sscanRead == 5)
-            {
-                opRet[op].stat = stat;
-                opRet[op].longOp = (String)(longOp);
-                opRet[op].shortOp = (String)(shortOp);
-                opRet[op].numOp = numOp;
-                opRet[op].act = act;
-                opsSeen += 1;
-            }
-            // TODO: Search for other possible patterns here
-            else
-            {
-                break; // Break out if pattern doesn't match.
-            }
-            opBegin = opEnd + 1; // Move opBegin to beginning of next value
+    // Sample responses:
+    // +COPS: (3,"Verizon Wireless","VzW","311480",8),,(0,1,2,3,4),(0,1,2)
+    // +COPS: (1,"313 100","313 100","313100",8),(2,"AT&T","AT&T","310410",8),(3,"311 480","311
+    // 480","311480",8),,(0,1,2,3,4),(0,1,2)
+
+    opBegin = response;
+
+    for (; op < maxOps; op++)
+    {
+        opBegin = strchr(opBegin, '(');
+        if (opBegin == nullptr)
+            break;
+        opEnd = strchr(opBegin, ')');
+        if (opEnd == nullptr)
+            break;
+
+        int sscanRead =
+            sscanf(opBegin, "(%d,\"%[^\"]\",\"%[^\"]\",\"%lu\",%d)%*s", &stat, longOp, shortOp, &numOp, &act);
+        if (sscanRead == 5)
+        {
+            opRet[op].stat = stat;
+            opRet[op].longOp = (String)(longOp);
+            opRet[op].shortOp = (String)(shortOp);
+            opRet[op].numOp = numOp;
+            opRet[op].act = act;
+            opsSeen += 1;
         }
+        // TODO: Search for other possible patterns here
+        else
+        {
+            break; // Break out if pattern doesn't match.
+        }
+        opBegin = opEnd + 1; // Move opBegin to beginning of next value
     }
 
-    free(response);
-
     return opsSeen;
 }
 
@@ -1992,48 +2208,28 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::setSMSMessageFormat(UBX_CELL_message_f
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::sendSMS(String number, String message)
 {
-    char *command;
-    char *messageCStr;
-    char *numberCStr;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
     UBX_CELL_error_t err;
 
-    numberCStr = ubx_cell_calloc_char(number.length() + 2);
-    if (numberCStr == nullptr)
+    command.begin(UBX_CELL_SEND_TEXT).quoted(number);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    number.toCharArray(numberCStr, number.length() + 1);
 
-    size_t cmdLen = strlen(UBX_CELL_SEND_TEXT) + strlen(numberCStr) + 8;
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command != nullptr)
-    {
-        snprintf(command, cmdLen, "%s=\"%s\"", UBX_CELL_SEND_TEXT, numberCStr);
-
-        err = sendCommandWithResponse(command, ">", nullptr, UBX_CELL_10_SEC_TIMEOUT);
-        free(command);
-        free(numberCStr);
-        if (err != UBX_CELL_ERROR_SUCCESS)
-            return err;
-
-        messageCStr = ubx_cell_calloc_char(message.length() + 1);
-        if (messageCStr == nullptr)
-        {
-            hwWrite(ASCII_CTRL_Z);
-            return UBX_CELL_ERROR_OUT_OF_MEMORY;
-        }
-        message.toCharArray(messageCStr, message.length() + 1);
-        messageCStr[message.length()] = ASCII_CTRL_Z;
-
-        err = sendCommandWithResponse(messageCStr, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_10_SEC_TIMEOUT,
-                                      minimumResponseAllocation, NOT_AT_COMMAND);
+    err = sendCommandWithResponse(command.c_str(), ">", nullptr, UBX_CELL_10_SEC_TIMEOUT);
+    if (err != UBX_CELL_ERROR_SUCCESS)
+        return err;
 
-        free(messageCStr);
-    }
-    else
+    // The message, ended by Ctrl-Z
+    command.begin("", false).raw(message.c_str(), message.length()).raw(&ASCII_CTRL_Z, 1);
+    if (command.overflow())
     {
-        free(numberCStr);
-        err = UBX_CELL_ERROR_OUT_OF_MEMORY;
+        hwWrite(ASCII_CTRL_Z);
+        return UBX_CELL_ERROR_OUT_OF_MEMORY;
     }
 
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_10_SEC_TIMEOUT,
+                                  minimumResponseAllocation, NOT_AT_COMMAND);
+
     return err;
 }
 
@@ -2091,7 +2287,11 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::readSMSmessage(int location, String *u
     UBX_CELL_error_t err;
     size_t cmdLen = strlen(UBX_CELL_READ_TEXT_MESSAGE) + 5;
     char command[cmdLen];
-    char response[1024];
+
+    size_t arenaMark = _arena.mark();
+    char *response = responseAlloc(1024);
+    if (response == nullptr)
+        return UBX_CELL_ERROR_OUT_OF_MEMORY;
 
     snprintf(command, cmdLen, "%s=%d", UBX_CELL_READ_TEXT_MESSAGE, location);
 
@@ -2116,6 +2316,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::readSMSmessage(int location, String *u
             }
             if ((*searchPtr == '\0') || (pointer == 12))
             {
+                responseRelease(response, arenaMark);
                 return UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
             }
             // Search to the next quote
@@ -2128,6 +2329,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::readSMSmessage(int location, String *u
             }
             if ((*searchPtr == '\0') || (pointer == 24))
             {
+                responseRelease(response, arenaMark);
                 return UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
             }
             // Skip two commas
@@ -2143,6 +2345,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::readSMSmessage(int location, String *u
             }
             if ((*searchPtr == '\0') || (pointer == 24))
             {
+                responseRelease(response, arenaMark);
                 return UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
             }
             // Search to the next new line
@@ -2155,6 +2358,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::readSMSmessage(int location, String *u
             }
             if ((*searchPtr == '\0') || (pointer == 512))
             {
+                responseRelease(response, arenaMark);
                 return UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
             }
         }
@@ -2168,6 +2372,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::readSMSmessage(int location, String *u
         err = UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
     }
 
+    responseRelease(response, arenaMark);
     return err;
 }
 
@@ -2215,75 +2420,277 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::setBaud(unsigned long baud)
     return err;
 }
 
-UBX_CELL_error_t SparkFun_ublox_Cellular::setFlowControl(UBX_CELL_flow_control_t value)
+UBX_CELL_error_t SparkFun_ublox_Cellular::detectBaud(void)
 {
-    UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_FLOW_CONTROL) + 16;
-    char command[cmdLen];
-
-    snprintf(command, cmdLen, "%s%d", UBX_CELL_FLOW_CONTROL, value);
+    UBX_CELL_error_t err = UBX_CELL_ERROR_NO_RESPONSE;
+    unsigned long candidates[NUM_SUPPORTED_BAUD + 2];
+    int numCandidates = 0;
 
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+    // Most likely first: the rate we last used, then the module's default, then the rest
+    if (_baud != 0)
+        candidates[numCandidates++] = _baud;
+    candidates[numCandidates++] = UBX_CELL_DEFAULT_BAUD_RATE;
+    for (int b = 0; b < NUM_SUPPORTED_BAUD; b++)
+        candidates[numCandidates++] = UBX_CELL_SUPPORTED_BAUD[b];
 
-    return err;
-}
+    for (int c = 0; c < numCandidates; c++)
+    {
+        bool tried = false;
+        for (int p = 0; p < c; p++)
+        {
+            if (candidates[p] == candidates[c])
+                tried = true;
+        }
+        if (tried)
+            continue;
 
-UBX_CELL_error_t SparkFun_ublox_Cellular::setGpioMode(UBX_CELL_gpio_t gpio, UBX_CELL_gpio_mode_t mode, int value)
-{
-    UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_COMMAND_GPIO) + 16;
-    char command[cmdLen];
+        switchBaud(candidates[c]);
 
-    // Example command: AT+UGPIOC=16,2
-    // Example command: AT+UGPIOC=23,0,1
-    if (mode == GPIO_OUTPUT)
-        snprintf(command, cmdLen, "%s=%d,%d,%d", UBX_CELL_COMMAND_GPIO, gpio, mode, value);
-    else
-        snprintf(command, cmdLen, "%s=%d,%d", UBX_CELL_COMMAND_GPIO, gpio, mode);
+        // The first AT may be lost in any junk left on the line by the previous rate. Give it two goes
+        for (int i = 0; (i < 2) && (err != UBX_CELL_ERROR_SUCCESS); i++)
+            err = sendCommandWithResponse(nullptr, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_BAUD_PROBE_TIMEOUT);
 
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_10_SEC_TIMEOUT);
+        if (err == UBX_CELL_ERROR_SUCCESS)
+        {
+            _baud = candidates[c];
+            if (_printDebug == true)
+            {
+                _debugPort->print(F("detectBaud: module found at "));
+                _debugPort->println(_baud);
+            }
+            return UBX_CELL_ERROR_SUCCESS;
+        }
+    }
 
-    return err;
+    if (_printDebug == true)
+        _debugPort->println(F("detectBaud: module not found!"));
+    return UBX_CELL_ERROR_NO_RESPONSE;
 }
 
-SparkFun_ublox_Cellular::UBX_CELL_gpio_mode_t SparkFun_ublox_Cellular::getGpioMode(UBX_CELL_gpio_t gpio)
+UBX_CELL_error_t SparkFun_ublox_Cellular::negotiateBaud(unsigned long maxBaud)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_COMMAND_GPIO) + 2;
-    char command[cmdLen];
-    char response[minimumResponseAllocation];
-    size_t charLen = 4;
-    char gpioChar[charLen];
-    char *gpioStart;
-    int gpioMode;
-
-    snprintf(command, cmdLen, "%s?", UBX_CELL_COMMAND_GPIO);
+    unsigned long throughput = 0;
 
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, response, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+    err = detectBaud();
+    if (err != UBX_CELL_ERROR_SUCCESS)
+        return err;
 
+    err = probeBaud(_baud, &throughput);
     if (err != UBX_CELL_ERROR_SUCCESS)
     {
-        return GPIO_MODE_INVALID;
+        if (_printDebug == true)
+            _debugPort->println(F("negotiateBaud: the link is not reliable at the current rate!"));
+        return err;
     }
+    _linkThroughput = throughput;
 
-    snprintf(gpioChar, charLen, "%d", gpio);                            // Convert GPIO to char array
-    gpioStart = strnstr(response, gpioChar, minimumResponseAllocation); // Find first occurence of GPIO in response
+    while (true)
+    {
+        // Find the next supported rate up. UBX_CELL_SUPPORTED_BAUD is not in order
+        unsigned long next = 0;
+        for (int b = 0; b < NUM_SUPPORTED_BAUD; b++)
+        {
+            unsigned long rate = UBX_CELL_SUPPORTED_BAUD[b];
+            if ((rate > _baud) && (rate <= maxBaud) && ((next == 0) || (rate < next)))
+                next = rate;
+        }
+        if (next == 0)
+            break; // Already at the top
 
-    if (gpioStart == nullptr)
-        return GPIO_MODE_INVALID; // If not found return invalid
-    sscanf(gpioStart, "%*d,%d\r\n", &gpioMode);
+        unsigned long previous = _baud;
+        if (setBaud(next) != UBX_CELL_ERROR_SUCCESS)
+            break; // The module does not support it
 
-    return (UBX_CELL_gpio_mode_t)gpioMode;
-}
+        switchBaud(next);
+        err = probeBaud(next, &throughput);
+        if ((err == UBX_CELL_ERROR_SUCCESS) && (throughput >= ((_linkThroughput / 10) * 9)))
+        {
+            _baud = next;
+            _linkThroughput = throughput;
+            if (_printDebug == true)
+            {
+                _debugPort->print(F("negotiateBaud: link qualified at "));
+                _debugPort->print(_baud);
+                _debugPort->print(F(". Bytes per second: "));
+                _debugPort->println(_linkThroughput);
+            }
+            continue;
+        }
 
-int SparkFun_ublox_Cellular::socketOpen(UBX_CELL_socket_protocol_t protocol, unsigned int localPort)
-{
-    UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_CREATE_SOCKET) + 10;
-    char command[cmdLen];
-    char response[minimumResponseAllocation];
-    int sockId = -1;
-    char *responseStart;
+        if (_printDebug == true)
+        {
+            _debugPort->print(F("negotiateBaud: link failed at "));
+            _debugPort->print(next);
+            _debugPort->print(F(". Returning to "));
+            _debugPort->println(previous);
+        }
+
+        // Step back down. The link is poor at this rate, so the command or its OK may be lost. After each attempt, check
+        // at the old rate whether the module got the message. If it never does, find the module and ask again from there
+        bool recovered = false;
+        for (int i = 0; (i < UBX_CELL_BAUD_PROBE_COUNT) && (!recovered); i++)
+        {
+            setBaud(previous);
+            switchBaud(previous);
+            recovered = (sendCommandWithResponse(nullptr, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                                 UBX_CELL_BAUD_PROBE_TIMEOUT) == UBX_CELL_ERROR_SUCCESS);
+            if (!recovered)
+                switchBaud(next);
+        }
+        if ((!recovered) && (detectBaud() == UBX_CELL_ERROR_SUCCESS) && (_baud != previous))
+        {
+            setBaud(previous);
+            switchBaud(previous);
+        }
+        _baud = previous;
+        break;
+    }
+
+    // Check we can still talk to the module
+    err = sendCommandWithResponse(nullptr, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+    if (err != UBX_CELL_ERROR_SUCCESS)
+        _linkThroughput = 0;
+    return err;
+}
+
+UBX_CELL_error_t SparkFun_ublox_Cellular::startMux(SparkFun_ublox_Cellular_CMUX &mux, int channel)
+{
+    UBX_CELL_error_t err;
+    size_t cmdLen = strlen(UBX_CELL_COMMAND_CMUX) + 16;
+    char command[cmdLen];
+
+    if (_mux != nullptr)
+        return UBX_CELL_ERROR_INVALID;
+
+    if (_rxFeed != nullptr) // The feed would be given the raw frames
+    {
+        if (_printDebug == true)
+            _debugPort->println(F("startMux: disable the RX feed first"));
+        return UBX_CELL_ERROR_INVALID;
+    }
+
+    // Basic option, UIH frames, our frame size
+    snprintf(command, cmdLen, "%s=0,0,,%d", UBX_CELL_COMMAND_CMUX, UBX_CELL_CMUX_FRAME_SIZE);
+    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+    if (err != UBX_CELL_ERROR_SUCCESS)
+        return err;
+
+    txFlush(UBX_CELL_SOCKET_WRITE_TIMEOUT); // Anything queued must go before the first frame
+
+    if (!mux.begin())
+    {
+        if (_printDebug == true)
+            _debugPort->println(F("startMux: the module did not open the channels"));
+        mux.end();
+        return UBX_CELL_ERROR_NO_RESPONSE;
+    }
+
+    _mux = &mux;
+    _muxHardSerial = _hardSerial;
+    _hardSerial = nullptr;
+#ifdef UBX_CELL_SOFTWARE_SERIAL_ENABLED
+    _muxSoftSerial = _softSerial;
+    _softSerial = nullptr;
+#endif
+    _muxTransport = _transport;
+    _transport = &mux.channel(channel);
+    _rxStageHead = 0;
+    _rxStageTail = 0;
+
+    return UBX_CELL_ERROR_SUCCESS;
+}
+
+UBX_CELL_error_t SparkFun_ublox_Cellular::stopMux(void)
+{
+    if (_mux == nullptr)
+        return UBX_CELL_ERROR_INVALID;
+
+    txFlush(UBX_CELL_SOCKET_WRITE_TIMEOUT);
+    _mux->end();
+    _mux = nullptr;
+
+    _hardSerial = _muxHardSerial;
+#ifdef UBX_CELL_SOFTWARE_SERIAL_ENABLED
+    _softSerial = _muxSoftSerial;
+#endif
+    _transport = _muxTransport;
+    _rxStageHead = 0;
+    _rxStageTail = 0;
+
+    // Check the module is back in command mode
+    return sendCommandWithResponse(nullptr, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+}
+
+UBX_CELL_error_t SparkFun_ublox_Cellular::setFlowControl(UBX_CELL_flow_control_t value)
+{
+    UBX_CELL_error_t err;
+    size_t cmdLen = strlen(UBX_CELL_FLOW_CONTROL) + 16;
+    char command[cmdLen];
+
+    snprintf(command, cmdLen, "%s%d", UBX_CELL_FLOW_CONTROL, value);
+
+    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+
+    return err;
+}
+
+UBX_CELL_error_t SparkFun_ublox_Cellular::setGpioMode(UBX_CELL_gpio_t gpio, UBX_CELL_gpio_mode_t mode, int value)
+{
+    UBX_CELL_error_t err;
+    size_t cmdLen = strlen(UBX_CELL_COMMAND_GPIO) + 16;
+    char command[cmdLen];
+
+    // Example command: AT+UGPIOC=16,2
+    // Example command: AT+UGPIOC=23,0,1
+    if (mode == GPIO_OUTPUT)
+        snprintf(command, cmdLen, "%s=%d,%d,%d", UBX_CELL_COMMAND_GPIO, gpio, mode, value);
+    else
+        snprintf(command, cmdLen, "%s=%d,%d", UBX_CELL_COMMAND_GPIO, gpio, mode);
+
+    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_10_SEC_TIMEOUT);
+
+    return err;
+}
+
+SparkFun_ublox_Cellular::UBX_CELL_gpio_mode_t SparkFun_ublox_Cellular::getGpioMode(UBX_CELL_gpio_t gpio)
+{
+    UBX_CELL_error_t err;
+    size_t cmdLen = strlen(UBX_CELL_COMMAND_GPIO) + 2;
+    char command[cmdLen];
+    char response[minimumResponseAllocation];
+    size_t charLen = 4;
+    char gpioChar[charLen];
+    char *gpioStart;
+    int gpioMode;
+
+    snprintf(command, cmdLen, "%s?", UBX_CELL_COMMAND_GPIO);
+
+    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, response, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+
+    if (err != UBX_CELL_ERROR_SUCCESS)
+    {
+        return GPIO_MODE_INVALID;
+    }
+
+    snprintf(gpioChar, charLen, "%d", gpio);                            // Convert GPIO to char array
+    gpioStart = strnstr(response, gpioChar, minimumResponseAllocation); // Find first occurence of GPIO in response
+
+    if (gpioStart == nullptr)
+        return GPIO_MODE_INVALID; // If not found return invalid
+    sscanf(gpioStart, "%*d,%d\r\n", &gpioMode);
+
+    return (UBX_CELL_gpio_mode_t)gpioMode;
+}
+
+int SparkFun_ublox_Cellular::socketOpen(UBX_CELL_socket_protocol_t protocol, unsigned int localPort)
+{
+    UBX_CELL_error_t err;
+    size_t cmdLen = strlen(UBX_CELL_CREATE_SOCKET) + 10;
+    char command[cmdLen];
+    char response[minimumResponseAllocation];
+    int sockId = -1;
+    char *responseStart;
 
     if (localPort == 0)
         snprintf(command, cmdLen, "%s=%d", UBX_CELL_CREATE_SOCKET, (int)protocol);
@@ -2338,6 +2745,11 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::socketClose(int socket, unsigned long
     const char *format = (UBX_CELL_STANDARD_RESPONSE_TIMEOUT == timeout) ? "%s=%d,1" : "%s=%d";
     snprintf(command, cmdLen, format, UBX_CELL_CLOSE_SOCKET, socket);
 
+    // Send anything still buffered first. The socket is closed, and the buffer freed, even if that fails
+    if ((socketFlush(socket) != UBX_CELL_ERROR_SUCCESS) && (_printDebug == true))
+        _debugPort->println(F("socketClose: buffered data was not sent"));
+    freeSocketWriteBuffer(socket);
+
     err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, response, timeout);
 
     if ((err != UBX_CELL_ERROR_SUCCESS) && (_printDebug == true))
@@ -2349,80 +2761,133 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::socketClose(int socket, unsigned long
     return err;
 }
 
+UBX_CELL_command_handle_t SparkFun_ublox_Cellular::socketCloseAsync(int socket, UBX_CELL_command_callback_t callback,
+                                                                    unsigned long timeout)
+{
+    SparkFun_ublox_Cellular_Command command(_txCommand);
+
+    command.begin(UBX_CELL_CLOSE_SOCKET).arg(socket);
+    if (command.overflow())
+        return UBX_CELL_COMMAND_HANDLE_INVALID;
+
+    // Sending anything still buffered takes a (blocking) +USOWR first
+    if ((socketFlush(socket) != UBX_CELL_ERROR_SUCCESS) && (_printDebug == true))
+        _debugPort->println(F("socketCloseAsync: buffered data was not sent"));
+    freeSocketWriteBuffer(socket);
+
+    return sendCommandAsync(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, callback, nullptr,
+                            minimumResponseAllocation, timeout);
+}
+
 UBX_CELL_error_t SparkFun_ublox_Cellular::socketConnect(int socket, const char *address, unsigned int port)
 {
-    UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_CONNECT_SOCKET) + strlen(address) + 11;
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_CONNECT_SOCKET).arg(socket).quoted(address).arg(port);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=%d,\"%s\",%d", UBX_CELL_CONNECT_SOCKET, socket, address, port);
 
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_IP_CONNECT_TIMEOUT);
+    return sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                   UBX_CELL_IP_CONNECT_TIMEOUT);
+}
+
+UBX_CELL_error_t SparkFun_ublox_Cellular::socketConnect(int socket, IPAddress address, unsigned int port)
+{
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    free(command);
+    command.begin(UBX_CELL_CONNECT_SOCKET).arg(socket).quoted(address).arg(port);
 
-    return err;
+    return sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                   UBX_CELL_IP_CONNECT_TIMEOUT);
 }
 
-UBX_CELL_error_t SparkFun_ublox_Cellular::socketConnect(int socket, IPAddress address, unsigned int port)
+void SparkFun_ublox_Cellular::setPromptDelay(unsigned long promptDelay)
 {
-    size_t charLen = 16;
-    char charAddress[charLen];
-    memset(charAddress, 0, 16);
-    snprintf(charAddress, charLen, "%d.%d.%d.%d", address[0], address[1], address[2], address[3]);
+    _promptDelay = promptDelay;
+}
 
-    return (socketConnect(socket, (const char *)charAddress, port));
+// The u-blox specification says to wait 50ms after receiving "@" (or ">") to write data. Only wait as long as
+// setPromptDelay says, measured from when commandStep matched the prompt: any time spent since then counts
+void SparkFun_ublox_Cellular::waitAfterPrompt(void)
+{
+    while (millis() - _command.foundAt < _promptDelay)
+    {
+        txDrain(); // Keep any queued data moving while we wait
+        yield();
+    }
 }
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::socketWrite(int socket, const char *str, int len)
 {
-    size_t cmdLen = strlen(UBX_CELL_WRITE_SOCKET) + 16;
-    char command[cmdLen];
+    int dataLen = len == -1 ? strlen(str) : len;
+    if ((socket < 0) || (socket >= UBX_CELL_NUM_SOCKETS) || (nullptr == _socketWriteBuffers[socket].data))
+        return socketWriteData(socket, str, dataLen);
+
+    UBX_CELL_socket_write_buffer_t *buffer = &_socketWriteBuffers[socket];
+
+    // If str will not fit, send what is buffered now: to make room for it, or to keep it in order ahead of str
+    if (buffer->used + dataLen > buffer->size)
+    {
+        UBX_CELL_error_t err = socketFlush(socket);
+        if (err != UBX_CELL_ERROR_SUCCESS)
+            return err;
+    }
+    if (dataLen >= buffer->size)
+        return socketWriteData(socket, str, dataLen);
+
+    if (buffer->used == 0)
+        buffer->firstAt = millis();
+    memcpy(&buffer->data[buffer->used], str, dataLen);
+    buffer->used += dataLen;
+
+    if ((buffer->used == buffer->size) || (millis() - buffer->firstAt >= buffer->flushDelay))
+        return socketFlush(socket);
+    return UBX_CELL_ERROR_SUCCESS;
+}
+
+UBX_CELL_error_t SparkFun_ublox_Cellular::socketWriteData(int socket, const char *str, int dataLen)
+{
+    SparkFun_ublox_Cellular_Command command(_txCommand);
     char response[minimumResponseAllocation];
     UBX_CELL_error_t err;
 
-    int dataLen = len == -1 ? strlen(str) : len;
-    snprintf(command, cmdLen, "%s=%d,%d", UBX_CELL_WRITE_SOCKET, socket, dataLen);
-
-    err = sendCommandWithResponse(command, "@", response, UBX_CELL_STANDARD_RESPONSE_TIMEOUT * 5);
+    if (_socketHexMode)
+        return socketWriteHex(socket, nullptr, 0, str, dataLen);
 
-    if (err == UBX_CELL_ERROR_SUCCESS)
+    // Anything longer than a single +USOWR can carry is sent in as many as it takes, each one straight after the last
+    int offset = 0;
+    do
     {
-        unsigned long writeDelay = millis();
-        while (millis() < (writeDelay + 50))
-            delay(1); // u-blox specification says to wait 50ms after receiving "@" to write data.
+        int chunk = dataLen - offset;
+        if (chunk > _saraR5maxSocketWrite)
+            chunk = _saraR5maxSocketWrite;
 
-        if (len == -1)
-        {
-            if (_printDebug == true)
-            {
-                _debugPort->print(F("socketWrite: writing: "));
-                _debugPort->println(str);
-            }
-            hwPrint(str);
-        }
-        else
+        command.begin(UBX_CELL_WRITE_SOCKET).arg(socket).arg(chunk);
+
+        err = sendCommandWithResponse(command.c_str(), "@", response, UBX_CELL_STANDARD_RESPONSE_TIMEOUT * 5);
+
+        if (err == UBX_CELL_ERROR_SUCCESS)
         {
+            waitAfterPrompt();
+
             if (_printDebug == true)
             {
-                _debugPort->print(F("socketWrite: writing "));
-                _debugPort->print(len);
+                _debugPort->print(F("socketWriteData: writing "));
+                _debugPort->print(chunk);
                 _debugPort->println(F(" bytes"));
             }
-            hwWriteData(str, len);
-        }
+            hwWriteData(&str[offset], chunk);
 
-        err = waitForResponse(UBX_CELL_RESPONSE_OK, UBX_CELL_RESPONSE_ERROR, UBX_CELL_SOCKET_WRITE_TIMEOUT);
-    }
+            err = waitForResponse(UBX_CELL_RESPONSE_OK, UBX_CELL_RESPONSE_ERROR, UBX_CELL_SOCKET_WRITE_TIMEOUT);
+        }
+        offset += chunk;
+    } while ((err == UBX_CELL_ERROR_SUCCESS) && (offset < dataLen));
 
     if (err != UBX_CELL_ERROR_SUCCESS)
     {
         if (_printDebug == true)
         {
-            _debugPort->print(F("socketWrite: Error: "));
+            _debugPort->print(F("socketWriteData: Error: "));
             _debugPort->print(err);
             _debugPort->print(F(" => {"));
             _debugPort->print(response);
@@ -2438,16 +2903,94 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::socketWrite(int socket, String str)
     return socketWrite(socket, str.c_str(), str.length());
 }
 
+bool SparkFun_ublox_Cellular::setSocketWriteBuffer(int socket, size_t size, unsigned long flushDelay)
+{
+    // A buffer is flushed with a single +USOWR. UDP is not buffered: each socketWriteUDP is a datagram
+    if ((socket < 0) || (socket >= UBX_CELL_NUM_SOCKETS) || (size > (size_t)_saraR5maxSocketWrite) ||
+        (_lastSocketProtocol[socket] == UBX_CELL_UDP))
+        return false;
+
+    if ((socketFlush(socket) != UBX_CELL_ERROR_SUCCESS) && (_printDebug == true))
+        _debugPort->println(F("setSocketWriteBuffer: buffered data was not sent"));
+    freeSocketWriteBuffer(socket);
+    if (size == 0)
+        return true;
+
+    char *data = new char[size];
+    if (nullptr == data)
+    {
+        if (_printDebug == true)
+            _debugPort->println(F("setSocketWriteBuffer: not enough memory for the buffer!"));
+        return false;
+    }
+
+    _socketWriteBuffers[socket] = {data, (int)size, 0, 0, flushDelay};
+    return true;
+}
+
+UBX_CELL_error_t SparkFun_ublox_Cellular::socketFlush(int socket)
+{
+    if ((socket < 0) || (socket >= UBX_CELL_NUM_SOCKETS) || (_socketWriteBuffers[socket].used == 0))
+        return UBX_CELL_ERROR_SUCCESS;
+
+    UBX_CELL_socket_write_buffer_t *buffer = &_socketWriteBuffers[socket];
+    int used = buffer->used;
+    buffer->used = 0; // Even if the write fails. Sending the start of it again would corrupt the stream
+    return socketWriteData(socket, buffer->data, used);
+}
+
+size_t SparkFun_ublox_Cellular::socketBuffered(int socket)
+{
+    if ((socket < 0) || (socket >= UBX_CELL_NUM_SOCKETS))
+        return 0;
+    return (size_t)_socketWriteBuffers[socket].used;
+}
+
+void SparkFun_ublox_Cellular::freeSocketWriteBuffer(int socket)
+{
+    if ((socket < 0) || (socket >= UBX_CELL_NUM_SOCKETS))
+        return;
+    if (nullptr != _socketWriteBuffers[socket].data)
+        delete[] _socketWriteBuffers[socket].data;
+    _socketWriteBuffers[socket] = {nullptr, 0, 0, 0, 0};
+}
+
+void SparkFun_ublox_Cellular::socketWriteService(void)
+{
+    for (int i = 0; i < UBX_CELL_NUM_SOCKETS; i++)
+    {
+        UBX_CELL_socket_write_buffer_t *buffer = &_socketWriteBuffers[i];
+        if ((buffer->used == 0) || (millis() - buffer->firstAt < buffer->flushDelay))
+            continue;
+
+        UBX_CELL_error_t err = socketFlush(i);
+        if ((err != UBX_CELL_ERROR_SUCCESS) && (_printDebug == true))
+        {
+            _debugPort->print(F("socketWriteService: socket "));
+            _debugPort->print(i);
+            _debugPort->print(F(" write error: "));
+            _debugPort->println(err);
+        }
+    }
+}
+
 UBX_CELL_error_t SparkFun_ublox_Cellular::socketWriteUDP(int socket, const char *address, int port, const char *str, int len)
 {
-    size_t cmdLen = 64;
-    char command[cmdLen];
+    SparkFun_ublox_Cellular_Command command(_txCommand);
     char response[minimumResponseAllocation];
     UBX_CELL_error_t err;
     int dataLen = len == -1 ? strlen(str) : len;
+    if (_socketHexMode)
+        return socketWriteHex(socket, address, port, str, dataLen);
 
-    snprintf(command, cmdLen, "%s=%d,\"%s\",%d,%d", UBX_CELL_WRITE_UDP_SOCKET, socket, address, port, dataLen);
-    err = sendCommandWithResponse(command, "@", response, UBX_CELL_STANDARD_RESPONSE_TIMEOUT * 5);
+    // Splitting a UDP write would split the datagram
+    if (dataLen > _saraR5maxSocketWrite)
+        return UBX_CELL_ERROR_UNEXPECTED_PARAM;
+
+    command.begin(UBX_CELL_WRITE_UDP_SOCKET).arg(socket).quoted(address).arg(port).arg(dataLen);
+    if (command.overflow())
+        return UBX_CELL_ERROR_OUT_OF_MEMORY;
+    err = sendCommandWithResponse(command.c_str(), "@", response, UBX_CELL_STANDARD_RESPONSE_TIMEOUT * 5);
 
     if (err == UBX_CELL_ERROR_SUCCESS)
     {
@@ -2472,14 +3015,54 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::socketWriteUDP(int socket, const char
     return err;
 }
 
+// In hex mode the data goes in the command itself: +USOWR=0,5,"48656C6C6F". There is no prompt to wait for
+UBX_CELL_error_t SparkFun_ublox_Cellular::socketWriteHex(int socket, const char *address, int port, const char *str,
+                                                         int len)
+{
+    SparkFun_ublox_Cellular_Command command(_txCommand);
+    UBX_CELL_error_t err = UBX_CELL_ERROR_SUCCESS;
+    int offset = 0;
+
+    // Splitting a UDP write would split the datagram
+    if ((address != nullptr) && (len > _saraR5maxSocketHexData))
+        return UBX_CELL_ERROR_UNEXPECTED_PARAM;
+
+    do
+    {
+        int chunk = len - offset;
+        if (chunk > _saraR5maxSocketHexData)
+            chunk = _saraR5maxSocketHexData;
+
+        if (address == nullptr)
+            command.begin(UBX_CELL_WRITE_SOCKET).arg(socket);
+        else
+            command.begin(UBX_CELL_WRITE_UDP_SOCKET).arg(socket).quoted(address).arg(port);
+        command.arg(chunk).hex(&str[offset], chunk);
+        if (command.overflow())
+            return UBX_CELL_ERROR_OUT_OF_MEMORY;
+
+        err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                      UBX_CELL_SOCKET_WRITE_TIMEOUT);
+        offset += chunk;
+    } while ((err == UBX_CELL_ERROR_SUCCESS) && (offset < len));
+
+    if ((err != UBX_CELL_ERROR_SUCCESS) && (_printDebug == true))
+    {
+        _debugPort->print(F("socketWriteHex: Error: "));
+        _debugPort->println(socketGetLastError());
+    }
+
+    return err;
+}
+
 UBX_CELL_error_t SparkFun_ublox_Cellular::socketWriteUDP(int socket, IPAddress address, int port, const char *str, int len)
 {
-    size_t charLen = 16;
     char charAddress[16];
-    memset(charAddress, 0, 16);
-    snprintf(charAddress, charLen, "%d.%d.%d.%d", address[0], address[1], address[2], address[3]);
+    SparkFun_ublox_Cellular_Command ip(charAddress);
+
+    ip.arg(address);
 
-    return (socketWriteUDP(socket, (const char *)charAddress, port, str, len));
+    return (socketWriteUDP(socket, ip.c_str(), port, str, len));
 }
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::socketWriteUDP(int socket, String address, int port, String str)
@@ -2489,20 +3072,18 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::socketWriteUDP(int socket, String addr
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::socketRead(int socket, int length, char *readDest, int *bytesRead)
 {
-    size_t cmdLen = strlen(UBX_CELL_READ_SOCKET) + 32;
-    char command[cmdLen];
-    // We only need enough to read _saraR5maxSocketRead bytes - not the whole thing
-    int responseLength = _saraR5maxSocketRead + strlen(UBX_CELL_READ_SOCKET) + minimumResponseAllocation;
-    char response[responseLength];
-    char *strBegin;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
+    // The data goes straight into readDest. The response only holds the +USORD: <socket>,<length>,"" around it
+    char response[minimumResponseAllocation];
     int readIndexTotal = 0;
-    int readIndexThisRead = 0;
     UBX_CELL_error_t err;
     int scanNum = 0;
     int readLength = 0;
     int socketStore = 0;
     int bytesLeftToRead = length;
     int bytesToRead;
+    int bytesStored;
+    int maxRead = _socketHexMode ? _saraR5maxSocketHexData : _saraR5maxSocketRead;
 
     // Set *bytesRead to zero
     if (bytesRead != nullptr)
@@ -2521,34 +3102,34 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::socketRead(int socket, int length, cha
 
     while (bytesLeftToRead > 0)
     {
-        if (bytesLeftToRead > _saraR5maxSocketRead) // Limit a single read to _saraR5maxSocketRead
-            bytesToRead = _saraR5maxSocketRead;
+        if (bytesLeftToRead > maxRead) // Limit a single read to _saraR5maxSocketRead (or the hex mode limit)
+            bytesToRead = maxRead;
         else
             bytesToRead = bytesLeftToRead;
 
-        snprintf(command, cmdLen, "%s=%d,%d", UBX_CELL_READ_SOCKET, socket, bytesToRead);
+        command.begin(UBX_CELL_READ_SOCKET).arg(socket).arg(bytesToRead);
 
-        err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, response,
-                                      UBX_CELL_STANDARD_RESPONSE_TIMEOUT, responseLength);
+        err = sendCommandWithPayload(command.c_str(), response, minimumResponseAllocation, &readDest[readIndexTotal],
+                                     bytesToRead, _socketHexMode, &bytesStored);
 
         if (err != UBX_CELL_ERROR_SUCCESS)
         {
             if (_printDebug == true)
             {
-                _debugPort->print(F("socketRead: sendCommandWithResponse err "));
+                _debugPort->print(F("socketRead: sendCommandWithPayload err "));
                 _debugPort->println(err);
             }
             return err;
         }
 
-        // Extract the data
-        char *searchPtr = strnstr(response, "+USORD:", responseLength);
+        // Extract the length
+        char *searchPtr = strnstr(response, "+USORD:", minimumResponseAllocation);
         if (searchPtr != nullptr)
         {
             searchPtr += strlen("+USORD:"); //  Move searchPtr to first char
-            while (*searchPtr == ' ')
-                searchPtr++; // skip spaces
-            scanNum = sscanf(searchPtr, "%d,%d", &socketStore, &readLength);
+            SparkFun_ublox_Cellular_Parser parser(searchPtr);
+            parser.integer(socketStore).integer(readLength);
+            scanNum = parser.count();
         }
         if (scanNum != 2)
         {
@@ -2582,22 +3163,14 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::socketRead(int socket, int length, cha
             return UBX_CELL_ERROR_ZERO_READ_LENGTH;
         }
 
-        // Find the first double-quote:
-        strBegin = strchr(searchPtr, '\"');
-
-        if (strBegin == nullptr)
+        // Check that all of the data arrived
+        if (bytesStored != readLength)
         {
+            if (_printDebug == true)
+                _debugPort->println(F("socketRead: data is incomplete!"));
             return UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
         }
-
-        // Now copy the data into readDest
-        readIndexThisRead = 1; // Start after the quote
-        while (readIndexThisRead < (readLength + 1))
-        {
-            readDest[readIndexTotal] = strBegin[readIndexThisRead];
-            readIndexTotal++;
-            readIndexThisRead++;
-        }
+        readIndexTotal += readLength;
 
         if (_printDebug == true)
             _debugPort->println(F("socketRead: success"));
@@ -2644,9 +3217,9 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::socketReadAvailable(int socket, int *l
         if (searchPtr != nullptr)
         {
             searchPtr += strlen("+USORD:"); //  Move searchPtr to first char
-            while (*searchPtr == ' ')
-                searchPtr++; // skip spaces
-            scanNum = sscanf(searchPtr, "%d,%d", &socketStore, &readLength);
+            SparkFun_ublox_Cellular_Parser parser(searchPtr);
+            parser.integer(socketStore).integer(readLength);
+            scanNum = parser.count();
         }
         if (scanNum != 2)
         {
@@ -2667,22 +3240,20 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::socketReadAvailable(int socket, int *l
 UBX_CELL_error_t SparkFun_ublox_Cellular::socketReadUDP(int socket, int length, char *readDest, IPAddress *remoteIPAddress,
                                          int *remotePort, int *bytesRead)
 {
-    size_t cmdLen = strlen(UBX_CELL_READ_UDP_SOCKET) + 32;
-    char command[cmdLen];
-    // We only need enough to read _saraR5maxSocketRead bytes - not the whole thing
-    int responseLength = _saraR5maxSocketRead + strlen(UBX_CELL_READ_UDP_SOCKET) + minimumResponseAllocation;
-    char response[responseLength];
-    char *strBegin;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
+    // The data goes straight into readDest. The response only holds the +USORF: header and the "" around the data
+    char response[minimumResponseAllocation];
     int readIndexTotal = 0;
-    int readIndexThisRead = 0;
     UBX_CELL_error_t err;
     int scanNum = 0;
-    int remoteIPstore[4] = {0, 0, 0, 0};
+    IPAddress remoteAddress = {0, 0, 0, 0};
     int portStore = 0;
     int readLength = 0;
     int socketStore = 0;
     int bytesLeftToRead = length;
     int bytesToRead;
+    int bytesStored;
+    int maxRead = _socketHexMode ? _saraR5maxSocketHexData : _saraR5maxSocketRead;
 
     // Set *bytesRead to zero
     if (bytesRead != nullptr)
@@ -2701,37 +3272,36 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::socketReadUDP(int socket, int length,
 
     while (bytesLeftToRead > 0)
     {
-        if (bytesLeftToRead > _saraR5maxSocketRead) // Limit a single read to _saraR5maxSocketRead
-            bytesToRead = _saraR5maxSocketRead;
+        if (bytesLeftToRead > maxRead) // Limit a single read to _saraR5maxSocketRead (or the hex mode limit)
+            bytesToRead = maxRead;
         else
             bytesToRead = bytesLeftToRead;
 
-        snprintf(command, cmdLen, "%s=%d,%d", UBX_CELL_READ_UDP_SOCKET, socket, bytesToRead);
+        command.begin(UBX_CELL_READ_UDP_SOCKET).arg(socket).arg(bytesToRead);
 
-        err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, response,
-                                      UBX_CELL_STANDARD_RESPONSE_TIMEOUT, responseLength);
+        err = sendCommandWithPayload(command.c_str(), response, minimumResponseAllocation, &readDest[readIndexTotal],
+                                     bytesToRead, _socketHexMode, &bytesStored);
 
         if (err != UBX_CELL_ERROR_SUCCESS)
         {
             if (_printDebug == true)
             {
-                _debugPort->print(F("socketReadUDP: sendCommandWithResponse err "));
+                _debugPort->print(F("socketReadUDP: sendCommandWithPayload err "));
                 _debugPort->println(err);
             }
             return err;
         }
 
-        // Extract the data
-        char *searchPtr = strnstr(response, "+USORF:", responseLength);
+        // Extract the remote address and the length
+        char *searchPtr = strnstr(response, "+USORF:", minimumResponseAllocation);
         if (searchPtr != nullptr)
         {
             searchPtr += strlen("+USORF:"); //  Move searchPtr to first char
-            while (*searchPtr == ' ')
-                searchPtr++; // skip spaces
-            scanNum = sscanf(searchPtr, "%d,\"%d.%d.%d.%d\",%d,%d", &socketStore, &remoteIPstore[0], &remoteIPstore[1],
-                             &remoteIPstore[2], &remoteIPstore[3], &portStore, &readLength);
+            SparkFun_ublox_Cellular_Parser parser(searchPtr);
+            parser.integer(socketStore).ipAddress(remoteAddress).integer(portStore).integer(readLength);
+            scanNum = parser.count();
         }
-        if (scanNum != 7)
+        if (scanNum != 4)
         {
             if (_printDebug == true)
             {
@@ -2763,34 +3333,19 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::socketReadUDP(int socket, int length,
             return UBX_CELL_ERROR_ZERO_READ_LENGTH;
         }
 
-        // Find the third double-quote
-        strBegin = strchr(searchPtr, '\"');
-        strBegin = strchr(strBegin + 1, '\"');
-        strBegin = strchr(strBegin + 1, '\"');
-
-        if (strBegin == nullptr)
+        // Check that all of the data arrived
+        if (bytesStored != readLength)
         {
+            if (_printDebug == true)
+                _debugPort->println(F("socketReadUDP: data is incomplete!"));
             return UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
         }
+        readIndexTotal += readLength;
 
-        // Now copy the data into readDest
-        readIndexThisRead = 1; // Start after the quote
-        while (readIndexThisRead < (readLength + 1))
+        // If remoteIPaddress is not nullptr, copy the remote IP address
+        if (remoteIPAddress != nullptr)
         {
-            readDest[readIndexTotal] = strBegin[readIndexThisRead];
-            readIndexTotal++;
-            readIndexThisRead++;
-        }
-
-        // If remoteIPaddress is not nullptr, copy the remote IP address
-        if (remoteIPAddress != nullptr)
-        {
-            IPAddress tempAddress;
-            for (int i = 0; i <= 3; i++)
-            {
-                tempAddress[i] = (uint8_t)remoteIPstore[i];
-            }
-            *remoteIPAddress = tempAddress;
+            *remoteIPAddress = remoteAddress;
         }
 
         // If remotePort is not nullptr, copy the remote port
@@ -2844,9 +3399,9 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::socketReadAvailableUDP(int socket, int
         if (searchPtr != nullptr)
         {
             searchPtr += strlen("+USORF:"); //  Move searchPtr to first char
-            while (*searchPtr == ' ')
-                searchPtr++; // skip spaces
-            scanNum = sscanf(searchPtr, "%d,%d", &socketStore, &readLength);
+            SparkFun_ublox_Cellular_Parser parser(searchPtr);
+            parser.integer(socketStore).integer(readLength);
+            scanNum = parser.count();
         }
         if (scanNum != 2)
         {
@@ -2885,6 +3440,10 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::socketDirectLinkMode(int socket)
 
     snprintf(command, cmdLen, "%s=%d", UBX_CELL_SOCKET_DIRECT_LINK, socket);
 
+    err = socketFlush(socket); // Buffered data goes ahead of anything written in Direct Link mode
+    if (err != UBX_CELL_ERROR_SUCCESS)
+        return err;
+
     err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_CONNECT, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
 
     return err;
@@ -2958,6 +3517,21 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::socketDirectLinkCongestionTimer(int so
     return err;
 }
 
+UBX_CELL_error_t SparkFun_ublox_Cellular::setSocketHexMode(bool enable)
+{
+    SparkFun_ublox_Cellular_Command command(_txCommand);
+    UBX_CELL_error_t err;
+
+    command.begin(UBX_CELL_UD_CONFIGURATION).arg(1).arg(enable ? 1 : 0);
+
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+    if (err == UBX_CELL_ERROR_SUCCESS)
+        _socketHexMode = enable;
+
+    return err;
+}
+
 UBX_CELL_error_t SparkFun_ublox_Cellular::querySocketType(int socket, UBX_CELL_socket_protocol_t *protocol)
 {
     size_t cmdLen = strlen(UBX_CELL_SOCKET_CONTROL) + 16;
@@ -3312,63 +3886,48 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::setHTTPserverIPaddress(int profile, IP
 UBX_CELL_error_t SparkFun_ublox_Cellular::setHTTPserverName(int profile, String server)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_HTTP_PROFILE) + 12 + server.length();
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
     if (profile >= UBX_CELL_NUM_HTTP_PROFILES)
         return UBX_CELL_ERROR_ERROR;
-
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_HTTP_PROFILE).arg(profile).arg(UBX_CELL_HTTP_OP_CODE_SERVER_NAME).quoted(server);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=%d,%d,\"%s\"", UBX_CELL_HTTP_PROFILE, profile, UBX_CELL_HTTP_OP_CODE_SERVER_NAME,
-             server.c_str());
-
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
 
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::setHTTPusername(int profile, String username)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_HTTP_PROFILE) + 12 + username.length();
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
     if (profile >= UBX_CELL_NUM_HTTP_PROFILES)
         return UBX_CELL_ERROR_ERROR;
-
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_HTTP_PROFILE).arg(profile).arg(UBX_CELL_HTTP_OP_CODE_USERNAME).quoted(username);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=%d,%d,\"%s\"", UBX_CELL_HTTP_PROFILE, profile, UBX_CELL_HTTP_OP_CODE_USERNAME,
-             username.c_str());
-
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
 
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::setHTTPpassword(int profile, String password)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_HTTP_PROFILE) + 12 + password.length();
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
     if (profile >= UBX_CELL_NUM_HTTP_PROFILES)
         return UBX_CELL_ERROR_ERROR;
-
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_HTTP_PROFILE).arg(profile).arg(UBX_CELL_HTTP_OP_CODE_PASSWORD).quoted(password);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=%d,%d,\"%s\"", UBX_CELL_HTTP_PROFILE, profile, UBX_CELL_HTTP_OP_CODE_PASSWORD,
-             password.c_str());
-
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
 
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
@@ -3408,21 +3967,16 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::setHTTPserverPort(int profile, int por
 UBX_CELL_error_t SparkFun_ublox_Cellular::setHTTPcustomHeader(int profile, String header)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_HTTP_PROFILE) + 12 + header.length();
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
     if (profile >= UBX_CELL_NUM_HTTP_PROFILES)
         return UBX_CELL_ERROR_ERROR;
-
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_HTTP_PROFILE).arg(profile).arg(UBX_CELL_HTTP_OP_CODE_ADD_CUSTOM_HEADERS).quoted(header);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=%d,%d,\"%s\"", UBX_CELL_HTTP_PROFILE, profile,
-             UBX_CELL_HTTP_OP_CODE_ADD_CUSTOM_HEADERS, header.c_str());
-
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
 
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
@@ -3449,39 +4003,31 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::setHTTPsecure(int profile, bool secure
 UBX_CELL_error_t SparkFun_ublox_Cellular::ping(String remote_host, int retry, int p_size, unsigned long timeout, int ttl)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_PING_COMMAND) + 48 + remote_host.length();
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_PING_COMMAND).quoted(remote_host).arg(retry).arg(p_size).arg(timeout).arg(ttl);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=\"%s\",%d,%d,%ld,%d", UBX_CELL_PING_COMMAND, remote_host.c_str(), retry, p_size,
-             timeout, ttl);
-
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
 
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::sendHTTPGET(int profile, String path, String responseFilename)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_HTTP_COMMAND) + 24 + path.length() + responseFilename.length();
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
     if (profile >= UBX_CELL_NUM_HTTP_PROFILES)
         return UBX_CELL_ERROR_ERROR;
-
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_HTTP_COMMAND).arg(profile).arg(UBX_CELL_HTTP_COMMAND_GET).quoted(path);
+    command.quoted(responseFilename);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=%d,%d,\"%s\",\"%s\"", UBX_CELL_HTTP_COMMAND, profile, UBX_CELL_HTTP_COMMAND_GET,
-             path.c_str(), responseFilename.c_str());
-
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
 
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
@@ -3489,21 +4035,17 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::sendHTTPPOSTdata(int profile, String p
                                             UBX_CELL_http_content_types_t httpContentType)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_HTTP_COMMAND) + 24 + path.length() + responseFilename.length() + data.length();
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
     if (profile >= UBX_CELL_NUM_HTTP_PROFILES)
         return UBX_CELL_ERROR_ERROR;
-
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_HTTP_COMMAND).arg(profile).arg(UBX_CELL_HTTP_COMMAND_POST_DATA).quoted(path);
+    command.quoted(responseFilename).quoted(data).arg(httpContentType);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=%d,%d,\"%s\",\"%s\",\"%s\",%d", UBX_CELL_HTTP_COMMAND, profile,
-             UBX_CELL_HTTP_COMMAND_POST_DATA, path.c_str(), responseFilename.c_str(), data.c_str(), httpContentType);
-
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
 
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
@@ -3511,23 +4053,17 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::sendHTTPPOSTfile(int profile, String p
                                             UBX_CELL_http_content_types_t httpContentType)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen =
-        strlen(UBX_CELL_HTTP_COMMAND) + 24 + path.length() + responseFilename.length() + requestFile.length();
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
     if (profile >= UBX_CELL_NUM_HTTP_PROFILES)
         return UBX_CELL_ERROR_ERROR;
-
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_HTTP_COMMAND).arg(profile).arg(UBX_CELL_HTTP_COMMAND_POST_FILE).quoted(path);
+    command.quoted(responseFilename).quoted(requestFile).arg(httpContentType);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=%d,%d,\"%s\",\"%s\",\"%s\",%d", UBX_CELL_HTTP_COMMAND, profile,
-             UBX_CELL_HTTP_COMMAND_POST_FILE, path.c_str(), responseFilename.c_str(), requestFile.c_str(),
-             httpContentType);
-
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
 
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
@@ -3581,47 +4117,39 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::nvMQTT(UBX_CELL_mqtt_nv_parameter_t pa
 UBX_CELL_error_t SparkFun_ublox_Cellular::setMQTTclientId(const String &clientId)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_MQTT_PROFILE) + clientId.length() + 10;
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_MQTT_PROFILE).arg(UBX_CELL_MQTT_PROFILE_CLIENT_ID).quoted(clientId);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=%d,\"%s\"", UBX_CELL_MQTT_PROFILE, UBX_CELL_MQTT_PROFILE_CLIENT_ID, clientId.c_str());
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::setMQTTserver(const String &serverName, int port)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_MQTT_PROFILE) + serverName.length() + 16;
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_MQTT_PROFILE).arg(UBX_CELL_MQTT_PROFILE_SERVERNAME).quoted(serverName).arg(port);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=%d,\"%s\",%d", UBX_CELL_MQTT_PROFILE, UBX_CELL_MQTT_PROFILE_SERVERNAME,
-             serverName.c_str(), port);
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::setMQTTcredentials(const String &userName, const String &pwd)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_MQTT_PROFILE) + userName.length() + pwd.length() + 16;
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_MQTT_PROFILE).arg(UBX_CELL_MQTT_PROFILE_USERNAMEPWD).quoted(userName).quoted(pwd);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=%d,\"%s\",\"%s\"", UBX_CELL_MQTT_PROFILE, UBX_CELL_MQTT_PROFILE_USERNAMEPWD,
-             userName.c_str(), pwd.c_str());
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
@@ -3665,31 +4193,26 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::disconnectMQTT(void)
 UBX_CELL_error_t SparkFun_ublox_Cellular::subscribeMQTTtopic(int max_Qos, const String &topic)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_MQTT_COMMAND) + 16 + topic.length();
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_MQTT_COMMAND).arg(UBX_CELL_MQTT_COMMAND_SUBSCRIBE).arg(max_Qos).quoted(topic);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=%d,%d,\"%s\"", UBX_CELL_MQTT_COMMAND, UBX_CELL_MQTT_COMMAND_SUBSCRIBE, max_Qos,
-             topic.c_str());
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::unsubscribeMQTTtopic(const String &topic)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_MQTT_COMMAND) + 16 + topic.length();
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_MQTT_COMMAND).arg(UBX_CELL_MQTT_COMMAND_UNSUBSCRIBE).quoted(topic);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=%d,\"%s\"", UBX_CELL_MQTT_COMMAND, UBX_CELL_MQTT_COMMAND_UNSUBSCRIBE, topic.c_str());
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
@@ -3700,7 +4223,9 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::readMQTT(int *pQos, String *pTopic, ui
     char *response;
     UBX_CELL_error_t err;
     int scanNum = 0;
-    int total_length, topic_length, data_length;
+    int total_length = 0;
+    int topic_length = 0;
+    int data_length = 0;
 
     // Set *bytesRead to zero
     if (bytesRead != nullptr)
@@ -3708,7 +4233,8 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::readMQTT(int *pQos, String *pTopic, ui
 
     // Allocate memory for the response
     int responseLength = readLength + minimumResponseAllocation;
-    response = ubx_cell_calloc_char(responseLength);
+    size_t arenaMark = _arena.mark();
+    response = responseAlloc(responseLength);
     if (response == nullptr)
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
 
@@ -3726,7 +4252,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::readMQTT(int *pQos, String *pTopic, ui
             _debugPort->print(F("readMQTT: sendCommandWithResponse err "));
             _debugPort->println(err);
         }
-        free(response);
+        responseRelease(response, arenaMark);
         return err;
     }
 
@@ -3736,10 +4262,9 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::readMQTT(int *pQos, String *pTopic, ui
     if (searchPtr != nullptr)
     {
         searchPtr += strlen("+UMQTTC:"); //  Move searchPtr to first char
-        while (*searchPtr == ' ')
-            searchPtr++; // skip spaces
-        scanNum =
-            sscanf(searchPtr, "%d,%d,%d,%d,\"%*[^\"]\",%d,\"", &cmd, pQos, &total_length, &topic_length, &data_length);
+        SparkFun_ublox_Cellular_Parser parser(searchPtr);
+        parser.integer(cmd).integer(*pQos).integer(total_length).integer(topic_length).skip().integer(data_length);
+        scanNum = parser.count();
     }
     if ((scanNum != 5) || (cmd != UBX_CELL_MQTT_COMMAND_READ))
     {
@@ -3748,7 +4273,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::readMQTT(int *pQos, String *pTopic, ui
             _debugPort->print(F("readMQTT: error: scanNum is "));
             _debugPort->println(scanNum);
         }
-        free(response);
+        responseRelease(response, arenaMark);
         return UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
     }
 
@@ -3788,7 +4313,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::readMQTT(int *pQos, String *pTopic, ui
             err = UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
         }
     }
-    free(response);
+    responseRelease(response, arenaMark);
 
     return err;
 }
@@ -3824,23 +4349,20 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::mqttPublishTextMsg(const String &topic
         msg_ptr++;
     }
 
-    size_t cmdLen = strlen(UBX_CELL_MQTT_COMMAND) + 20 + topic.length() + msg_len;
-    char *command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
-        return UBX_CELL_ERROR_OUT_OF_MEMORY;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    snprintf(command, cmdLen, "%s=%d,%u,%u,0,\"%s\",\"%s\"", UBX_CELL_MQTT_COMMAND, UBX_CELL_MQTT_COMMAND_PUBLISH, qos,
-             (retain ? 1 : 0), topic.c_str(), sanitized_msg);
+    command.begin(UBX_CELL_MQTT_COMMAND).arg(UBX_CELL_MQTT_COMMAND_PUBLISH).arg(qos).arg(retain ? 1 : 0).arg(0);
+    command.quoted(topic).quoted(sanitized_msg);
+    if (command.overflow())
+        return UBX_CELL_ERROR_OUT_OF_MEMORY;
 
-    sendCommand(command, true);
+    sendCommand(command.c_str(), true);
     err = waitForResponse(UBX_CELL_RESPONSE_MORE, UBX_CELL_RESPONSE_ERROR, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     if (err == UBX_CELL_ERROR_SUCCESS)
     {
         sendCommand(msg, false);
         err = waitForResponse(UBX_CELL_RESPONSE_OK, UBX_CELL_RESPONSE_ERROR, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     }
-
-    free(command);
     return err;
 }
 
@@ -3862,23 +4384,20 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::mqttPublishBinaryMsg(const String &top
     }
 
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_MQTT_COMMAND) + 20 + topic.length();
-    char *command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
-        return UBX_CELL_ERROR_OUT_OF_MEMORY;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    snprintf(command, cmdLen, "%s=%d,%u,%u,\"%s\",%u", UBX_CELL_MQTT_COMMAND, UBX_CELL_MQTT_COMMAND_PUBLISHBINARY, qos,
-             (retain ? 1 : 0), topic.c_str(), msg_len);
+    command.begin(UBX_CELL_MQTT_COMMAND).arg(UBX_CELL_MQTT_COMMAND_PUBLISHBINARY).arg(qos).arg(retain ? 1 : 0);
+    command.quoted(topic).arg(msg_len);
+    if (command.overflow())
+        return UBX_CELL_ERROR_OUT_OF_MEMORY;
 
-    sendCommand(command, true);
+    sendCommand(command.c_str(), true);
     err = waitForResponse(UBX_CELL_RESPONSE_MORE, UBX_CELL_RESPONSE_ERROR, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     if (err == UBX_CELL_ERROR_SUCCESS)
     {
         sendCommand(msg, false);
         err = waitForResponse(UBX_CELL_RESPONSE_OK, UBX_CELL_RESPONSE_ERROR, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     }
-
-    free(command);
     return err;
 }
 
@@ -3890,18 +4409,15 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::mqttPublishFromFile(const String &topi
     }
 
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_MQTT_COMMAND) + 20 + topic.length() + filename.length();
-    char *command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
-        return UBX_CELL_ERROR_OUT_OF_MEMORY;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    snprintf(command, cmdLen, "%s=%d,%u,%u,\"%s\",\"%s\"", UBX_CELL_MQTT_COMMAND, UBX_CELL_MQTT_COMMAND_PUBLISHFILE,
-             qos, (retain ? 1 : 0), topic.c_str(), filename.c_str());
+    command.begin(UBX_CELL_MQTT_COMMAND).arg(UBX_CELL_MQTT_COMMAND_PUBLISHFILE).arg(qos).arg(retain ? 1 : 0);
+    command.quoted(topic).quoted(filename);
+    if (command.overflow())
+        return UBX_CELL_ERROR_OUT_OF_MEMORY;
 
-    sendCommand(command, true);
+    sendCommand(command.c_str(), true);
     err = waitForResponse(UBX_CELL_RESPONSE_OK, UBX_CELL_RESPONSE_ERROR, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
-
-    free(command);
     return err;
 }
 
@@ -3998,19 +4514,15 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::disconnectFTP(void)
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::ftpGetFile(const String &filename)
 {
-    size_t cmdLen = strlen(UBX_CELL_FTP_COMMAND) + (2 * filename.length()) + 16;
-    char *command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
-        return UBX_CELL_ERROR_OUT_OF_MEMORY;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    snprintf(command, cmdLen, "%s=%d,\"%s\",\"%s\"", UBX_CELL_FTP_COMMAND, UBX_CELL_FTP_COMMAND_GET_FILE,
-             filename.c_str(), filename.c_str());
+    command.begin(UBX_CELL_FTP_COMMAND).arg(UBX_CELL_FTP_COMMAND_GET_FILE).quoted(filename).quoted(filename);
+    if (command.overflow())
+        return UBX_CELL_ERROR_OUT_OF_MEMORY;
     // memset(response, 0, sizeof(response));
-    // sendCommandWithResponse(command, UBX_CELL_RESPONSE_CONNECT, response, 8000 /* ms */, response_len);
-    UBX_CELL_error_t err =
-        sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
-
-    free(command);
+    // sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_CONNECT, response, 8000 /* ms */, response_len);
+    UBX_CELL_error_t err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                                   UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
@@ -4080,33 +4592,28 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::configSecurityProfileString(int secpro
                                                        String value)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_SEC_PROFILE) + value.length() + 10;
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_SEC_PROFILE).arg(secprofile).arg(parameter).quoted(value);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=%d,%d,\"%s\"", UBX_CELL_SEC_PROFILE, secprofile, parameter, value.c_str());
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
-    free(command);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     return err;
 }
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::setSecurityManager(UBX_CELL_sec_manager_opcode_t opcode,
                                               UBX_CELL_sec_manager_parameter_t parameter, String name, String data)
 {
-    size_t cmdLen = strlen(UBX_CELL_SEC_MANAGER) + name.length() + 20;
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
     char response[minimumResponseAllocation];
     UBX_CELL_error_t err;
-
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
-        return UBX_CELL_ERROR_OUT_OF_MEMORY;
     int dataLen = data.length();
-    snprintf(command, cmdLen, "%s=%d,%d,\"%s\",%d", UBX_CELL_SEC_MANAGER, opcode, parameter, name.c_str(), dataLen);
+    command.begin(UBX_CELL_SEC_MANAGER).arg(opcode).arg(parameter).quoted(name).arg(dataLen);
+    if (command.overflow())
+        return UBX_CELL_ERROR_OUT_OF_MEMORY;
 
-    err = sendCommandWithResponse(command, ">", response, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+    err = sendCommandWithResponse(command.c_str(), ">", response, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     if (err == UBX_CELL_ERROR_SUCCESS)
     {
         if (_printDebug == true)
@@ -4130,8 +4637,6 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::setSecurityManager(UBX_CELL_sec_manage
             _debugPort->println(F("}"));
         }
     }
-
-    free(command);
     return err;
 }
 
@@ -4390,25 +4895,20 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::gpsAidingServerConf(const char *primar
 // OK for text files. But will fail with binary files (containing \0) on some platforms.
 UBX_CELL_error_t SparkFun_ublox_Cellular::appendFileContents(String filename, const char *str, int len)
 {
-    size_t cmdLen = strlen(UBX_CELL_FILE_SYSTEM_DOWNLOAD_FILE) + filename.length() + 10;
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
     char response[minimumResponseAllocation];
     UBX_CELL_error_t err;
-
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
-        return UBX_CELL_ERROR_OUT_OF_MEMORY;
     int dataLen = len == -1 ? strlen(str) : len;
-    snprintf(command, cmdLen, "%s=\"%s\",%d", UBX_CELL_FILE_SYSTEM_DOWNLOAD_FILE, filename.c_str(), dataLen);
-
-    err = sendCommandWithResponse(command, ">", response, UBX_CELL_STANDARD_RESPONSE_TIMEOUT * 2);
+    command.begin(UBX_CELL_FILE_SYSTEM_DOWNLOAD_FILE).quoted(filename).arg(dataLen);
+    if (command.overflow())
+        return UBX_CELL_ERROR_OUT_OF_MEMORY;
 
-    unsigned long writeDelay = millis();
-    while (millis() < (writeDelay + 50))
-        delay(1); // uBlox specification says to wait 50ms after receiving "@" to write data.
+    err = sendCommandWithResponse(command.c_str(), ">", response, UBX_CELL_STANDARD_RESPONSE_TIMEOUT * 2);
 
     if (err == UBX_CELL_ERROR_SUCCESS)
     {
+        waitAfterPrompt();
+
         if (_printDebug == true)
         {
             _debugPort->print(F("fileDownload: writing "));
@@ -4430,8 +4930,6 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::appendFileContents(String filename, co
             _debugPort->println(F("}"));
         }
     }
-
-    free(command);
     return err;
 }
 
@@ -4444,8 +4942,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::appendFileContents(String filename, St
 UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, String *contents)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_FILE_SYSTEM_READ_FILE) + filename.length() + 8;
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
     char *response;
 
     // Start by getting the file size so we know in advance how much data to expect
@@ -4460,13 +4957,12 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, Strin
         }
         return err;
     }
-
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_FILE_SYSTEM_READ_FILE).quoted(filename);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=\"%s\"", UBX_CELL_FILE_SYSTEM_READ_FILE, filename.c_str());
 
-    response = ubx_cell_calloc_char(fileSize + minimumResponseAllocation);
+    size_t arenaMark = _arena.mark();
+    response = responseAlloc(fileSize + minimumResponseAllocation);
     if (response == nullptr)
     {
         if (_printDebug == true)
@@ -4474,7 +4970,6 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, Strin
             _debugPort->print(F("getFileContents: response alloc failed: "));
             _debugPort->println(fileSize + minimumResponseAllocation);
         }
-        free(command);
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
     }
 
@@ -4482,7 +4977,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, Strin
     // Note to self: if the file contents contain "OK\r\n" sendCommandWithResponse will return true too early...
     // To try and avoid this, look for \"\r\nOK\r\n
     const char fileReadTerm[] = "\r\nOK\r\n"; // LARA-R6 returns "\"\r\n\r\nOK\r\n" while SARA-R5 return "\"\r\nOK\r\n";
-    err = sendCommandWithResponse(command, fileReadTerm, response, (5 * UBX_CELL_STANDARD_RESPONSE_TIMEOUT),
+    err = sendCommandWithResponse(command.c_str(), fileReadTerm, response, (5 * UBX_CELL_STANDARD_RESPONSE_TIMEOUT),
                                   (fileSize + minimumResponseAllocation));
 
     if (err != UBX_CELL_ERROR_SUCCESS)
@@ -4492,8 +4987,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, Strin
             _debugPort->print(F("getFileContents: sendCommandWithResponse returned err "));
             _debugPort->println(err);
         }
-        free(command);
-        free(response);
+        responseRelease(response, arenaMark);
         return err;
     }
 
@@ -4517,8 +5011,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, Strin
                 {
                     _debugPort->println(F("getFileContents: third quote not found!"));
                 }
-                free(command);
-                free(response);
+                responseRelease(response, arenaMark);
                 return UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
             }
 
@@ -4557,9 +5050,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, Strin
             _debugPort->println(F("getFileContents: strnstr failed!"));
         err = UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
     }
-
-    free(command);
-    free(response);
+    responseRelease(response, arenaMark);
     return err;
 }
 
@@ -4567,8 +5058,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, Strin
 UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, char *contents)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_FILE_SYSTEM_READ_FILE) + filename.length() + 8;
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
     char *response;
 
     // Start by getting the file size so we know in advance how much data to expect
@@ -4583,13 +5073,12 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, char
         }
         return err;
     }
-
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_FILE_SYSTEM_READ_FILE).quoted(filename);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=\"%s\"", UBX_CELL_FILE_SYSTEM_READ_FILE, filename.c_str());
 
-    response = ubx_cell_calloc_char(fileSize + minimumResponseAllocation);
+    size_t arenaMark = _arena.mark();
+    response = responseAlloc(fileSize + minimumResponseAllocation);
     if (response == nullptr)
     {
         if (_printDebug == true)
@@ -4597,7 +5086,6 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, char
             _debugPort->print(F("getFileContents: response alloc failed: "));
             _debugPort->println(fileSize + minimumResponseAllocation);
         }
-        free(command);
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
     }
 
@@ -4605,7 +5093,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, char
     // Note to self: if the file contents contain "OK\r\n" sendCommandWithResponse will return true too early...
     // To try and avoid this, look for \"\r\nOK\r\n
     const char fileReadTerm[] = "\"\r\nOK\r\n";
-    err = sendCommandWithResponse(command, fileReadTerm, response, (5 * UBX_CELL_STANDARD_RESPONSE_TIMEOUT),
+    err = sendCommandWithResponse(command.c_str(), fileReadTerm, response, (5 * UBX_CELL_STANDARD_RESPONSE_TIMEOUT),
                                   (fileSize + minimumResponseAllocation));
 
     if (err != UBX_CELL_ERROR_SUCCESS)
@@ -4615,8 +5103,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, char
             _debugPort->print(F("getFileContents: sendCommandWithResponse returned err "));
             _debugPort->println(err);
         }
-        free(command);
-        free(response);
+        responseRelease(response, arenaMark);
         return err;
     }
 
@@ -4640,8 +5127,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, char
                 {
                     _debugPort->println(F("getFileContents: third quote not found!"));
                 }
-                free(command);
-                free(response);
+                responseRelease(response, arenaMark);
                 return UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
             }
 
@@ -4676,9 +5162,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileContents(String filename, char
             _debugPort->println(F("getFileContents: strnstr failed!"));
         err = UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
     }
-
-    free(command);
-    free(response);
+    responseRelease(response, arenaMark);
     return err;
 }
 
@@ -4692,23 +5176,24 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileBlock(const String &filename, c
     }
 
     // trying to get a byte at a time does not seem to be reliable so this method must use
-    // a real UART.
-    if (_hardSerial == nullptr)
+    // a real UART (or a transport, or the RX feed).
+    if ((_hardSerial == nullptr) && (_transport == nullptr) && (_rxFeed == nullptr))
     {
         if (_printDebug == true)
         {
-            _debugPort->println(F("getFileBlock: only works with a hardware UART"));
+            _debugPort->println(F("getFileBlock: only works with a hardware UART, a transport or the RX feed"));
         }
         return UBX_CELL_ERROR_INVALID;
     }
 
-    size_t cmdLen = filename.length() + 32;
-    char *cmd = ubx_cell_calloc_char(cmdLen);
-    if (cmd == nullptr)
+    SparkFun_ublox_Cellular_Command command(_txCommand);
+    command.begin(UBX_CELL_FILE_SYSTEM_READ_BLOCK).quoted(filename).arg(offset).arg(requested_length);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(cmd, cmdLen, "at+urdblock=\"%s\",%zu,%zu\r\n", filename.c_str(), offset, requested_length);
-    sendCommand(cmd, false);
+    sendCommand(command.c_str(), true);
 
+    // The command has gone. Reuse its buffer for the response header
+    char *cmd = _txCommand;
     int ich;
     char ch;
     int quote_count = 0;
@@ -4716,13 +5201,14 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileBlock(const String &filename, c
 
     while (quote_count < 3)
     {
-        ich = _hardSerial->read();
-        if (ich < 0)
+        if (rxFill() == 0)
         {
             continue;
         }
+        ich = (int)_rxStage[_rxStageHead++];
         ch = (char)(ich & 0xFF);
-        cmd[bytes_read++] = ch;
+        if (bytes_read < UBX_CELL_COMMAND_BUFFER_SIZE - 1)
+            cmd[bytes_read++] = ch;
         if (ch == '"')
         {
             quote_count++;
@@ -4739,14 +5225,14 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileBlock(const String &filename, c
     // Example response:
     // +URDBLOCK: "wombat.bin",64000,"<data starts here>... "<cr><lf>
     size_t data_length = strtoul(&cmd[comma_idx], nullptr, 10);
-    free(cmd);
 
     bytes_read = 0;
     size_t bytes_remaining = data_length;
     while (bytes_read < data_length)
     {
         // This method seems more reliable than reading a byte at a time.
-        size_t rc = _hardSerial->readBytes(&buffer[bytes_read], bytes_remaining);
+        // rxRead returns any staged bytes first, then reads the rest from the port in a single call
+        size_t rc = rxRead(&buffer[bytes_read], bytes_remaining);
         bytes_read += rc;
         bytes_remaining -= rc;
     }
@@ -4757,16 +5243,15 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileBlock(const String &filename, c
 UBX_CELL_error_t SparkFun_ublox_Cellular::getFileSize(String filename, int *size)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_FILE_SYSTEM_LIST_FILES) + filename.length() + 8;
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
     char response[minimumResponseAllocation];
 
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_FILE_SYSTEM_LIST_FILES).arg(2).quoted(filename);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=2,\"%s\"", UBX_CELL_FILE_SYSTEM_LIST_FILES, filename.c_str());
 
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, response, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, response,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
     if (err != UBX_CELL_ERROR_SUCCESS)
     {
         if (_printDebug == true)
@@ -4777,7 +5262,6 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileSize(String filename, int *size
             _debugPort->print(response);
             _debugPort->println(F("}"));
         }
-        free(command);
         return err;
     }
 
@@ -4790,7 +5274,6 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileSize(String filename, int *size
             _debugPort->print(response);
             _debugPort->println(F("}"));
         }
-        free(command);
         return UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
     }
 
@@ -4800,23 +5283,20 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::getFileSize(String filename, int *size
         responseStart++; // skip spaces
     sscanf(responseStart, "%d", &fileSize);
     *size = fileSize;
-
-    free(command);
     return err;
 }
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::deleteFile(String filename)
 {
     UBX_CELL_error_t err;
-    size_t cmdLen = strlen(UBX_CELL_FILE_SYSTEM_DELETE_FILE) + filename.length() + 8;
-    char *command;
+    SparkFun_ublox_Cellular_Command command(_txCommand);
 
-    command = ubx_cell_calloc_char(cmdLen);
-    if (command == nullptr)
+    command.begin(UBX_CELL_FILE_SYSTEM_DELETE_FILE).quoted(filename);
+    if (command.overflow())
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
-    snprintf(command, cmdLen, "%s=\"%s\"", UBX_CELL_FILE_SYSTEM_DELETE_FILE, filename.c_str());
 
-    err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr, UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+    err = sendCommandWithResponse(command.c_str(), UBX_CELL_RESPONSE_OK_OR_ERROR, nullptr,
+                                  UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
 
     if (err != UBX_CELL_ERROR_SUCCESS)
     {
@@ -4826,8 +5306,6 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::deleteFile(String filename)
             _debugPort->println(err);
         }
     }
-
-    free(command);
     return err;
 }
 
@@ -5116,19 +5594,54 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::waitForResponse(const char *expectedRe
     unsigned long timeIn;
     bool found = false;
     bool error = false;
-    int responseIndex = 0, errorIndex = 0;
     // bool printedSomething = false;
 
+    // Any asynchronous command's response would be mistaken for this one. Let it finish first
+    commandFinish();
+
     timeIn = millis();
 
-    int responseLen = (int)strlen(expectedResponse);
-    int errorLen = (int)strlen(expectedError);
+    _responseMatcher.clear();
+    int errorMatch = _responseMatcher.add(expectedError); // Added first: the error wins if both complete together
+    _responseMatcher.add(expectedResponse);
+
+    _rxResultCode = UBX_CELL_RESULT_NONE;
+    _rxResultCause = -1;
+    rxWaitFor(expectedResponse, expectedError);
+
+    // Prune what is already in the backlog. From here on, lines are pruned as they complete
+    pruneBacklog();
+    _rxCommandActive = true;
 
-    while ((!found) && ((timeIn + timeout) > millis()))
+    while ((!found) && ((millis() - timeIn) < timeout))
     {
-        if (hwAvailable() > 0) // hwAvailable can return -1 if the serial port is nullptr
+        txDrain(); // Keep any queued data moving while we wait
+
+        if (rxFill() == 0) // Drain the serial port into _rxStage in one call
+        {
+            // Measure once: millis() may pass the deadline between a check and the subtraction
+            unsigned long elapsed = millis() - timeIn;
+            if (elapsed >= timeout)
+                break;
+            rxWait(timeout - elapsed); // Sleep until the response may have arrived, or just yield
+            continue;
+        }
+
+        // Work through the staged bytes. Stop as soon as we have a match so any trailing bytes stay staged
+        while ((!found) && (_rxStageHead < _rxStageTail))
         {
-            char c = readChar();
+            char c = _rxStage[_rxStageHead++];
+
+            // The RX ring holds the backlog of any events that came in while waiting for response.
+            // To be processed later within bufferedPoll().
+            // Note: the expectedResponse or expectedError will also be added to the backlog.
+            // The ring's tokenizer also knows when c is binary payload (e.g. the data of a +USORD response). That
+            // must not be matched: it could contain anything, including the expected response
+            bool payload = (_rxPayloadRemaining > 0);
+            rxRingPut(c); // rxRingPut won't overflow the ring
+            if (payload)
+                continue;
+
             // if (_printDebug == true)
             // {
             //   if (printedSomething == false)
@@ -5136,53 +5649,26 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::waitForResponse(const char *expectedRe
             //   _debugPort->write(c);
             //   printedSomething = true;
             // }
-            if ((responseIndex < responseLen) && (c == expectedResponse[responseIndex]))
-            {
-                if (++responseIndex == responseLen)
-                {
-                    found = true;
-                }
-            }
-            else
-            {
-                responseIndex = ((responseIndex < responseLen) && (c == expectedResponse[0])) ? 1 : 0;
-            }
-            if ((errorIndex < errorLen) && (c == expectedError[errorIndex]))
-            {
-                if (++errorIndex == errorLen)
-                {
-                    error = true;
-                    found = true;
-                }
-            }
-            else
+            int match = _responseMatcher.match(c);
+            if (match >= 0)
             {
-                errorIndex = ((errorIndex < errorLen) && (c == expectedError[0])) ? 1 : 0;
+                error = (match == errorMatch);
+                found = true;
             }
-            //_saraResponseBacklog is a global array that holds the backlog of any events
-            // that came in while waiting for response. To be processed later within bufferedPoll().
-            // Note: the expectedResponse or expectedError will also be added to the backlog.
-            // The backlog is only used by bufferedPoll to process the URCs - which are all readable.
-            // bufferedPoll uses strtok - which does not like nullptr characters.
-            // So let's make sure no NULLs end up in the backlog!
-            if (_saraResponseBacklogLength < _RXBuffSize) // Don't overflow the buffer
+            // Any error final result code (e.g. +CME ERROR: <n>) ends the wait too, rather than the timeout
+            if ((!found) && (_rxResultCode > UBX_CELL_RESULT_OK))
             {
-                if (c == '\0')
-                    _saraResponseBacklog[_saraResponseBacklogLength++] = '0'; // Change NULLs to ASCII Zeros
-                else
-                    _saraResponseBacklog[_saraResponseBacklogLength++] = c;
+                error = true;
+                found = true;
             }
         }
-        else
-        {
-            yield();
-        }
     }
 
     // if (_printDebug == true)
     //   if (printedSomething)
     //     _debugPort->println();
 
+    _rxCommandActive = false;
     pruneBacklog(); // Prune any incoming non-actionable URC's and responses/errors from the backlog
 
     if (found == true)
@@ -5192,27 +5678,30 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::waitForResponse(const char *expectedRe
             _debugAtPort->print((error == true) ? expectedError : expectedResponse);
         }
 
-        return (error == true) ? UBX_CELL_ERROR_ERROR : UBX_CELL_ERROR_SUCCESS;
+        return setLastResult((error == true) ? UBX_CELL_ERROR_ERROR : UBX_CELL_ERROR_SUCCESS);
     }
 
-    return UBX_CELL_ERROR_NO_RESPONSE;
+    return setLastResult(UBX_CELL_ERROR_NO_RESPONSE);
 }
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::sendCommandWithResponse(const char *command, const char *expectedResponse,
                                                    char *responseDest, unsigned long commandTimeout, int destSize,
                                                    bool at)
 {
-    bool found = false;
-    bool error = false;
-    int responseIndex = 0;
-    int errorIndex = 0;
-    int destIndex = 0;
-    unsigned int charsRead = 0;
-    int responseLen = 0;
-    int errorLen = 0;
+    commandBegin(command, expectedResponse, responseDest, destSize, commandTimeout, at);
+
+    while (!commandStep())
+        rxWait(commandTimeLeft()); // Sleep until more may have arrived, or just yield
+
+    return commandEnd();
+}
+
+// Send the command and get ready to collect its response. Any asynchronous command still in progress is finished
+// first (by sendCommand)
+void SparkFun_ublox_Cellular::commandBegin(const char *command, const char *expectedResponse, char *responseDest,
+                                           int destSize, unsigned long commandTimeout, bool at)
+{
     const char *expectedError = nullptr;
-    bool printResponse = false; // Change to true to print the full response
-    bool printedSomething = false;
 
     if (_printDebug == true)
     {
@@ -5221,111 +5710,164 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::sendCommandWithResponse(const char *co
     }
 
     sendCommand(command, at); // Sending command needs to dump data to backlog buffer as well.
-    unsigned long timeIn = millis();
     if (UBX_CELL_RESPONSE_OK_OR_ERROR == expectedResponse)
     {
         expectedResponse = UBX_CELL_RESPONSE_OK;
         expectedError = UBX_CELL_RESPONSE_ERROR;
-        responseLen = sizeof(UBX_CELL_RESPONSE_OK) - 1;
-        errorLen = sizeof(UBX_CELL_RESPONSE_ERROR) - 1;
-    }
-    else
-    {
-        responseLen = (int)strlen(expectedResponse);
     }
 
-    while ((!found) && ((timeIn + commandTimeout) > millis()))
+    _command.expectedResponse = expectedResponse;
+    _command.responseDest = responseDest;
+    _command.destSize = destSize;
+    _command.destIndex = 0;
+    _command.found = false;
+    _command.error = false;
+    _command.printedSomething = false;
+    _command.charsRead = 0;
+    _command.timeIn = millis();
+    _command.timeout = commandTimeout;
+    _command.foundAt = _command.timeIn;
+    _command.payloadDest = nullptr;
+    _command.payloadSize = 0;
+    _command.payloadLength = 0;
+    _command.payloadHex = false;
+    _command.payloadHalf = false;
+    _command.payloadError = false;
+
+    _responseMatcher.clear();
+    _command.errorMatch = _responseMatcher.add(expectedError); // Added first: the error wins if both complete together
+    _responseMatcher.add(expectedResponse);
+
+    _rxResultCode = UBX_CELL_RESULT_NONE;
+    _rxResultCause = -1;
+    rxWaitFor(expectedResponse, expectedError);
+
+    // Prune what is already in the backlog. From here on, lines are pruned as they complete
+    pruneBacklog();
+    _rxCommandActive = true;
+}
+
+// Millis left before the command in progress times out, or 0 if it already has
+unsigned long SparkFun_ublox_Cellular::commandTimeLeft(void)
+{
+    unsigned long elapsed = millis() - _command.timeIn; // Measure once: millis() may pass the deadline meanwhile
+    return (elapsed >= _command.timeout) ? 0 : _command.timeout - elapsed;
+}
+
+// Work through everything which has arrived for the command in progress. Returns false once there is nothing more to
+// read, or true if the response (or error) has been found or the command has timed out
+bool SparkFun_ublox_Cellular::commandStep(void)
+{
+    bool printResponse = false; // Change to true to print the full response
+
+    while ((!_command.found) && ((millis() - _command.timeIn) < _command.timeout))
     {
-        if (hwAvailable() > 0) // hwAvailable can return -1 if the serial port is nullptr
+        txDrain(); // Keep any queued data moving while we wait
+
+        if (rxFill() == 0) // Drain the serial port into _rxStage in one call
+            return false;
+
+        // Work through the staged bytes. Stop as soon as we have a match so any trailing bytes stay staged
+        while ((!_command.found) && (_rxStageHead < _rxStageTail))
         {
-            char c = readChar();
+            // The tokenizer has found the start of a binary payload. If the command has somewhere to put it, move it
+            // there in one go. It never goes into the ring, so the tokenizer just counts it off
+            if ((_rxPayloadRemaining > 0) && (_command.payloadDest != nullptr))
+            {
+                int len = _rxStageTail - _rxStageHead;
+                if (len > _rxPayloadRemaining)
+                    len = _rxPayloadRemaining;
+                commandPayload(&_rxStage[_rxStageHead], len);
+                _rxStageHead += len;
+                _rxPayloadRemaining -= len;
+                _command.charsRead += len;
+                continue;
+            }
+
+            char c = _rxStage[_rxStageHead++];
             if ((printResponse = true) && (_printDebug == true))
             {
-                if (printedSomething == false)
+                if (_command.printedSomething == false)
                 {
                     _debugPort->print(F("sendCommandWithResponse: Response: "));
-                    printedSomething = true;
+                    _command.printedSomething = true;
                 }
                 _debugPort->write(c);
             }
-            if (responseDest != nullptr)
+            if (_command.responseDest != nullptr)
             {
-                if (destIndex < destSize) // Only add this char to response if there is room for it
-                    responseDest[destIndex] = c;
-                destIndex++;
-                if (destIndex == destSize)
+                if (_command.destIndex < _command.destSize) // Only add this char to response if there is room for it
+                    _command.responseDest[_command.destIndex] = c;
+                _command.destIndex++;
+                if (_command.destIndex == _command.destSize)
                 {
                     if (_printDebug == true)
                     {
-                        if ((printResponse = true) && (printedSomething))
+                        if ((printResponse = true) && (_command.printedSomething))
                             _debugPort->println();
                         _debugPort->print(F("sendCommandWithResponse: Panic! responseDest is full!"));
-                        if ((printResponse = true) && (printedSomething))
+                        if ((printResponse = true) && (_command.printedSomething))
                             _debugPort->print(F("sendCommandWithResponse: Ignored response: "));
                     }
                 }
             }
-            charsRead++;
-            if ((errorIndex < errorLen) && (c == expectedError[errorIndex]))
-            {
-                if (++errorIndex == errorLen)
-                {
-                    error = true;
-                    found = true;
-                }
-            }
-            else
-            {
-                errorIndex = ((errorIndex < errorLen) && (c == expectedError[0])) ? 1 : 0;
-            }
-            if ((responseIndex < responseLen) && (c == expectedResponse[responseIndex]))
-            {
-                if (++responseIndex == responseLen)
-                {
-                    found = true;
-                }
-            }
-            else
+            _command.charsRead++;
+
+            // The RX ring holds the backlog of any events that came in while waiting for response.
+            // To be processed later within bufferedPoll().
+            // Note: the expectedResponse or expectedError will also be added to the backlog
+            // The ring's tokenizer also knows when c is binary payload (e.g. the data of a +USORD response). That
+            // must not be matched: it could contain anything, including OK or ERROR
+            bool payload = (_rxPayloadRemaining > 0);
+            rxRingPut(c); // rxRingPut won't overflow the ring
+            if (payload)
+                continue;
+
+            int match = _responseMatcher.match(c);
+            if (match >= 0)
             {
-                responseIndex = ((responseIndex < responseLen) && (c == expectedResponse[0])) ? 1 : 0;
+                _command.error = (match == _command.errorMatch);
+                _command.found = true;
+                _command.foundAt = millis();
             }
-            //_saraResponseBacklog is a global array that holds the backlog of any events
-            // that came in while waiting for response. To be processed later within bufferedPoll().
-            // Note: the expectedResponse or expectedError will also be added to the backlog
-            // The backlog is only used by bufferedPoll to process the URCs - which are all readable.
-            // bufferedPoll uses strtok - which does not like NULL characters.
-            // So let's make sure no NULLs end up in the backlog!
-            if (_saraResponseBacklogLength < _RXBuffSize) // Don't overflow the buffer
+            // Any error final result code (e.g. +CME ERROR: <n>) ends the command too, rather than the timeout
+            if ((!_command.found) && (_rxResultCode > UBX_CELL_RESULT_OK))
             {
-                if (c == '\0')
-                    _saraResponseBacklog[_saraResponseBacklogLength++] = '0'; // Change NULLs to ASCII Zeros
-                else
-                    _saraResponseBacklog[_saraResponseBacklogLength++] = c;
+                _command.error = true;
+                _command.found = true;
             }
         }
-        else
-        {
-            yield();
-        }
     }
 
+    return true;
+}
+
+// Finish the command in progress: prune what is left of its response from the backlog and work out the result
+UBX_CELL_error_t SparkFun_ublox_Cellular::commandEnd(void)
+{
+    char *responseDest = _command.responseDest;
+
     if (_printDebug == true)
-        if ((printResponse = true) && (printedSomething))
+        if (_command.printedSomething)
             _debugPort->println();
 
+    _rxCommandActive = false;
     pruneBacklog(); // Prune any incoming non-actionable URC's and responses/errors from the backlog
 
-    if (found)
+    if ((responseDest != nullptr) && (_command.destIndex < _command.destSize))
+        responseDest[_command.destIndex] = '\0';
+
+    if (_command.found)
     {
-        if ((true == _printAtDebug) && ((nullptr != responseDest) || (nullptr != expectedResponse)))
+        if ((true == _printAtDebug) && ((nullptr != responseDest) || (nullptr != _command.expectedResponse)))
         {
-            _debugAtPort->print((nullptr != responseDest) ? responseDest : expectedResponse);
+            _debugAtPort->print((nullptr != responseDest) ? responseDest : _command.expectedResponse);
         }
-        return error ? UBX_CELL_ERROR_ERROR : UBX_CELL_ERROR_SUCCESS;
+        return setLastResult(_command.error ? UBX_CELL_ERROR_ERROR : UBX_CELL_ERROR_SUCCESS);
     }
-    else if (charsRead == 0)
+    else if (_command.charsRead == 0)
     {
-        return UBX_CELL_ERROR_NO_RESPONSE;
+        return setLastResult(UBX_CELL_ERROR_NO_RESPONSE);
     }
     else
     {
@@ -5333,8 +5875,191 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::sendCommandWithResponse(const char *co
         {
             _debugAtPort->print(responseDest);
         }
-        return UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
+        return setLastResult(UBX_CELL_ERROR_UNEXPECTED_RESPONSE);
+    }
+}
+
+// Store len bytes of payload. In hex mode they are digits: a digit left over from an odd len is kept for next time.
+// Anything which does not fit in payloadDest is dropped
+void SparkFun_ublox_Cellular::commandPayload(const char *src, int len)
+{
+    int room = _command.payloadSize - _command.payloadLength;
+    char *dest = &_command.payloadDest[_command.payloadLength];
+
+    if (!_command.payloadHex)
+    {
+        if (len > room)
+            len = room;
+        memcpy(dest, src, len);
+        _command.payloadLength += len;
+        return;
+    }
+
+    if ((_command.payloadHalf) && (len > 0))
+    {
+        char pair[2] = {_command.payloadDigit, *src++};
+        len--;
+        _command.payloadHalf = false;
+        if (room > 0)
+        {
+            if (!SparkFun_ublox_Cellular_Hex::decode(pair, 1, dest++))
+                _command.payloadError = true;
+            _command.payloadLength++;
+            room--;
+        }
+    }
+
+    int pairs = len / 2;
+    int stored = (pairs < room) ? pairs : room;
+    if (!SparkFun_ublox_Cellular_Hex::decode(src, stored, dest))
+        _command.payloadError = true;
+    _command.payloadLength += stored;
+
+    if (len & 1)
+    {
+        _command.payloadDigit = src[len - 1];
+        _command.payloadHalf = true;
+    }
+}
+
+UBX_CELL_error_t SparkFun_ublox_Cellular::sendCommandWithPayload(const char *command, char *responseDest, int destSize,
+                                                                 char *payloadDest, int payloadSize, bool hex,
+                                                                 int *payloadLength)
+{
+    commandBegin(command, UBX_CELL_RESPONSE_OK_OR_ERROR, responseDest, destSize, UBX_CELL_STANDARD_RESPONSE_TIMEOUT,
+                 true);
+    _command.payloadDest = payloadDest;
+    _command.payloadSize = payloadSize;
+    _command.payloadHex = hex;
+
+    while (!commandStep())
+        rxWait(commandTimeLeft()); // Sleep until more may have arrived, or just yield
+
+    UBX_CELL_error_t err = commandEnd();
+    *payloadLength = _command.payloadLength;
+    if ((err == UBX_CELL_ERROR_SUCCESS) && (_command.payloadError))
+        err = UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
+    return err;
+}
+
+UBX_CELL_command_handle_t SparkFun_ublox_Cellular::sendCommandAsync(const char *command, const char *expectedResponse,
+                                                                   UBX_CELL_command_callback_t callback,
+                                                                   char *responseDest, int destSize,
+                                                                   unsigned long commandTimeout, bool at)
+{
+    if (_asyncHandle != UBX_CELL_COMMAND_HANDLE_INVALID)
+    {
+        if (_printDebug == true)
+            _debugPort->println(F("sendCommandAsync: a command is already in progress"));
+        return UBX_CELL_COMMAND_HANDLE_INVALID;
+    }
+    commandCallback(); // Call back the previous command first. Only one callback is held back at a time
+    if (_asyncHandle != UBX_CELL_COMMAND_HANDLE_INVALID)
+        return UBX_CELL_COMMAND_HANDLE_INVALID; // That callback sent a command of its own
+
+    commandBegin(command, expectedResponse, responseDest, destSize, commandTimeout, at);
+
+    if (++_asyncLastHandle == UBX_CELL_COMMAND_HANDLE_INVALID) // Skip the invalid handle when the count wraps
+        _asyncLastHandle++;
+    _asyncHandle = _asyncLastHandle;
+    _asyncResult = UBX_CELL_ERROR_IN_PROGRESS;
+    _asyncCallback = callback;
+    return _asyncHandle;
+}
+
+// Collect whatever has arrived for the asynchronous command. If that completes it, finish it and call its callback -
+// or, if callNow is false, hold the callback back for commandCallback.
+// Returns true if no asynchronous command is in progress (any more)
+bool SparkFun_ublox_Cellular::commandService(bool callNow)
+{
+    if (_asyncHandle == UBX_CELL_COMMAND_HANDLE_INVALID)
+        return true;
+
+    if (!commandStep())
+        return false;
+
+    // Clear the command before the callback, so the callback can send the next one
+    _asyncResult = commandEnd();
+    _asyncDoneCallback = _asyncCallback;
+    _asyncDoneHandle = _asyncHandle;
+    _asyncDoneResult = _asyncResult;
+    _asyncDoneResponse = _command.responseDest;
+    _asyncHandle = UBX_CELL_COMMAND_HANDLE_INVALID;
+    _asyncCallback = nullptr;
+
+    if (_asyncOperatorsResponse != nullptr) // getOperatorsAsync: parse now, so the response can be freed
+    {
+        _asyncDoneOperators = 0;
+        if (_asyncResult == UBX_CELL_ERROR_SUCCESS)
+            _asyncDoneOperators = parseOperators(_asyncOperatorsResponse, _asyncOperators, _asyncMaxOperators);
+        _asyncDoneOperatorsCallback = _asyncOperatorsCallback;
+        _asyncDoneResponse = nullptr;
+        free(_asyncOperatorsResponse);
+        _asyncOperatorsResponse = nullptr;
+        _asyncOperators = nullptr;
+        _asyncOperatorsCallback = nullptr;
+    }
+
+    if (callNow)
+        commandCallback();
+    return true;
+}
+
+void SparkFun_ublox_Cellular::commandCallback(void)
+{
+    UBX_CELL_command_callback_t callback = _asyncDoneCallback;
+    UBX_CELL_operators_callback_t operatorsCallback = _asyncDoneOperatorsCallback;
+    _asyncDoneCallback = nullptr; // Before the call: the callback may complete another command
+    _asyncDoneOperatorsCallback = nullptr;
+    if (callback != nullptr)
+        callback(_asyncDoneHandle, _asyncDoneResult, _asyncDoneResponse);
+    else if (operatorsCallback != nullptr)
+        operatorsCallback(_asyncDoneHandle, _asyncDoneResult, _asyncDoneOperators);
+}
+
+// Called before a blocking command is sent. Any callback waits: the caller may already have built its command in
+// _txCommand, and a callback which sends the next command would overwrite it, then take its place
+void SparkFun_ublox_Cellular::commandFinish(void)
+{
+    while (!commandService(false))
+        rxWait(commandTimeLeft());
+}
+
+UBX_CELL_error_t SparkFun_ublox_Cellular::commandResult(UBX_CELL_command_handle_t handle)
+{
+    if (handle == UBX_CELL_COMMAND_HANDLE_INVALID)
+        return UBX_CELL_ERROR_INVALID;
+    if (handle == _asyncHandle)
+        return UBX_CELL_ERROR_IN_PROGRESS;
+    if (handle == _asyncLastHandle)
+        return _asyncResult;
+    return UBX_CELL_ERROR_INVALID;
+}
+
+UBX_CELL_error_t SparkFun_ublox_Cellular::waitForCommand(UBX_CELL_command_handle_t handle)
+{
+    while ((handle != UBX_CELL_COMMAND_HANDLE_INVALID) && (handle == _asyncHandle))
+    {
+        if (!commandService())
+            rxWait(commandTimeLeft());
     }
+    commandCallback(); // In case it completed while a blocking command waited for it
+    return commandResult(handle);
+}
+
+UBX_CELL_error_t SparkFun_ublox_Cellular::setLastResult(UBX_CELL_error_t err)
+{
+    _lastResult.error = err;
+    _lastResult.code = _rxResultCode;
+    _lastResult.cause = _rxResultCause;
+    if ((_printDebug == true) &&
+        ((_rxResultCode == UBX_CELL_RESULT_CME_ERROR) || (_rxResultCode == UBX_CELL_RESULT_CMS_ERROR)))
+    {
+        _debugPort->print((_rxResultCode == UBX_CELL_RESULT_CME_ERROR) ? F("setLastResult: +CME ERROR: ")
+                                                                       : F("setLastResult: +CMS ERROR: "));
+        _debugPort->println(_rxResultCause);
+    }
+    return err;
 }
 
 // Send a custom command with an expected (potentially partial) response, store entire response
@@ -5347,6 +6072,10 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::sendCustomCommandWithResponse(const ch
 
 void SparkFun_ublox_Cellular::sendCommand(const char *command, bool at)
 {
+    // The module handles one command at a time. Let any asynchronous command finish first. Its callback waits: if it
+    // sent the next command, that would take this one's place, and could overwrite it in _txCommand
+    commandFinish();
+
     // Check for incoming serial data. Copy it into the backlog
 
     // Important note:
@@ -5360,20 +6089,14 @@ void SparkFun_ublox_Cellular::sendCommand(const char *command, bool at)
     if (hwAvailable() > 0) // hwAvailable can return -1 if the serial port is NULL
     {
         while (((millis() - timeIn) < _rxWindowMillis) &&
-               (_saraResponseBacklogLength < _RXBuffSize)) // May need to escape on newline?
+               (_rxRingUsed < _RXBuffSize)) // May need to escape on newline?
         {
-            if (hwAvailable() > 0) // hwAvailable can return -1 if the serial port is NULL
-            {
-                //_saraResponseBacklog is a global array that holds the backlog of any events
-                // that came in while waiting for response. To be processed later within bufferedPoll().
-                // Note: the expectedResponse or expectedError will also be added to the backlog
-                // The backlog is only used by bufferedPoll to process the URCs - which are all readable.
-                // bufferedPoll uses strtok - which does not like NULL characters.
-                // So let's make sure no NULLs end up in the backlog!
-                char c = readChar();
-                if (c == '\0') // Make sure no NULL characters end up in the backlog! Change them to ASCII Zeros
-                    c = '0';
-                _saraResponseBacklog[_saraResponseBacklogLength++] = c;
+            // The RX ring holds the backlog of any events that came in while waiting for response.
+            // To be processed later within bufferedPoll().
+            // Note: the expectedResponse or expectedError will also be added to the backlog
+            // The backlog is only used by bufferedPoll to process the URCs - which are all readable.
+            if (rxRingFill() > 0)
+            {
                 timeIn = millis();
             }
             else
@@ -5383,17 +6106,25 @@ void SparkFun_ublox_Cellular::sendCommand(const char *command, bool at)
         }
     }
 
-    // Now send the command
+    // Only a dial command ends with NO CARRIER, BUSY etc. Otherwise they are unsolicited (a call or a Direct Link
+    // connection ending) and must not end the command
+    const char *name = (command != nullptr) ? command : "";
+    if ((!at) && ((name[0] == 'A') || (name[0] == 'a')) && ((name[1] == 'T') || (name[1] == 't')))
+        name += 2;
+    _rxDialing = (name[0] == 'D') || (name[0] == 'd');
+
+    // Now send the command: "AT", the command and the terminator in a single write
+    UBX_CELL_iovec_t iov[3];
+    iov[0].data = UBX_CELL_COMMAND_AT;
+    iov[0].len = strlen(UBX_CELL_COMMAND_AT);
+    iov[1].data = (command != nullptr) ? command : ""; // at() sends plain "AT" with a nullptr command
+    iov[1].len = strlen(iov[1].data);
+    iov[2].data = "\r\n";
+    iov[2].len = 2;
     if (at)
-    {
-        hwPrint(UBX_CELL_COMMAND_AT);
-        hwPrint(command);
-        hwPrint("\r\n");
-    }
+        hwWritev(iov, 3);
     else
-    {
-        hwPrint(command);
-    }
+        hwWritev(&iov[1], 1);
 }
 
 UBX_CELL_error_t SparkFun_ublox_Cellular::parseSocketReadIndication(int socket, int length)
@@ -5410,7 +6141,8 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::parseSocketReadIndication(int socket,
     if ((_socketReadCallback == nullptr) && (_socketReadCallbackPlus == nullptr))
         return UBX_CELL_ERROR_INVALID;
 
-    readDest = ubx_cell_calloc_char(length + 1);
+    size_t arenaMark = _arena.mark();
+    readDest = responseAlloc(length + 1);
     if (readDest == nullptr)
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
 
@@ -5418,7 +6150,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::parseSocketReadIndication(int socket,
     err = socketRead(socket, length, readDest, &bytesRead);
     if (err != UBX_CELL_ERROR_SUCCESS)
     {
-        free(readDest);
+        responseRelease(readDest, arenaMark);
         return err;
     }
 
@@ -5441,7 +6173,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::parseSocketReadIndication(int socket,
         _socketReadCallbackPlus(socket, (const char *)readDest, bytesRead, dummyAddress, dummyPort);
     }
 
-    free(readDest);
+    responseRelease(readDest, arenaMark);
     return UBX_CELL_ERROR_SUCCESS;
 }
 
@@ -5461,7 +6193,8 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::parseSocketReadIndicationUDP(int socke
     if ((_socketReadCallback == nullptr) && (_socketReadCallbackPlus == nullptr))
         return UBX_CELL_ERROR_INVALID;
 
-    readDest = ubx_cell_calloc_char(length + 1);
+    size_t arenaMark = _arena.mark();
+    readDest = responseAlloc(length + 1);
     if (readDest == nullptr)
         return UBX_CELL_ERROR_OUT_OF_MEMORY;
 
@@ -5469,7 +6202,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::parseSocketReadIndicationUDP(int socke
     err = socketReadUDP(socket, length, readDest, &remoteAddress, &remotePort, &bytesRead);
     if (err != UBX_CELL_ERROR_SUCCESS)
     {
-        free(readDest);
+        responseRelease(readDest, arenaMark);
         return err;
     }
 
@@ -5489,7 +6222,7 @@ UBX_CELL_error_t SparkFun_ublox_Cellular::parseSocketReadIndicationUDP(int socke
         _socketReadCallbackPlus(socket, (const char *)readDest, bytesRead, remoteAddress, remotePort);
     }
 
-    free(readDest);
+    responseRelease(readDest, arenaMark);
     return UBX_CELL_ERROR_SUCCESS;
 }
 
@@ -5535,7 +6268,11 @@ size_t SparkFun_ublox_Cellular::hwPrint(const char *s)
     {
         _debugAtPort->print(s);
     }
-    if (_hardSerial != nullptr)
+    if ((_txQueue != nullptr) && (s != nullptr))
+    {
+        return txQueueData(s, strlen(s));
+    }
+    else if (_hardSerial != nullptr)
     {
         return _hardSerial->print(s);
     }
@@ -5545,6 +6282,10 @@ size_t SparkFun_ublox_Cellular::hwPrint(const char *s)
         return _softSerial->print(s);
     }
 #endif
+    else if ((_transport != nullptr) && (s != nullptr))
+    {
+        return _transport->write(s, strlen(s));
+    }
 
     return (size_t)0;
 }
@@ -5555,7 +6296,11 @@ size_t SparkFun_ublox_Cellular::hwWriteData(const char *buff, int len)
     {
         _debugAtPort->write(buff, len);
     }
-    if (_hardSerial != nullptr)
+    if ((_txQueue != nullptr) && (0 < len))
+    {
+        return txQueueData(buff, len);
+    }
+    else if (_hardSerial != nullptr)
     {
         return _hardSerial->write((const uint8_t *)buff, len);
     }
@@ -5565,6 +6310,10 @@ size_t SparkFun_ublox_Cellular::hwWriteData(const char *buff, int len)
         return _softSerial->write((const uint8_t *)buff, len);
     }
 #endif
+    else if ((_transport != nullptr) && (0 < len))
+    {
+        return _transport->write(buff, len);
+    }
     return (size_t)0;
 }
 
@@ -5574,7 +6323,11 @@ size_t SparkFun_ublox_Cellular::hwWrite(const char c)
     {
         _debugAtPort->write(c);
     }
-    if (_hardSerial != nullptr)
+    if (_txQueue != nullptr)
+    {
+        return txQueueData(&c, 1);
+    }
+    else if (_hardSerial != nullptr)
     {
         return _hardSerial->write(c);
     }
@@ -5584,15 +6337,178 @@ size_t SparkFun_ublox_Cellular::hwWrite(const char c)
         return _softSerial->write(c);
     }
 #endif
+    else if (_transport != nullptr)
+    {
+        return _transport->write(&c, 1);
+    }
+
+    return (size_t)0;
+}
+
+size_t SparkFun_ublox_Cellular::hwWritev(const UBX_CELL_iovec_t *iov, int count)
+{
+    size_t written = 0;
+
+    if (true == _printAtDebug)
+    {
+        for (int i = 0; i < count; i++)
+            _debugAtPort->write((const uint8_t *)iov[i].data, iov[i].len);
+    }
+    if (_txQueueUsed > 0) // Commands must not overtake queued data
+        txFlush(UBX_CELL_SOCKET_WRITE_TIMEOUT);
+    if (_hardSerial != nullptr)
+    {
+        for (int i = 0; i < count; i++)
+            written += _hardSerial->write((const uint8_t *)iov[i].data, iov[i].len);
+    }
+#ifdef UBX_CELL_SOFTWARE_SERIAL_ENABLED
+    else if (_softSerial != nullptr)
+    {
+        for (int i = 0; i < count; i++)
+            written += _softSerial->write((const uint8_t *)iov[i].data, iov[i].len);
+    }
+#endif
+    else if (_transport != nullptr)
+    {
+        written = _transport->writev(iov, count); // The transport can gather the segments into one call
+    }
+
+    return written;
+}
+
+size_t SparkFun_ublox_Cellular::hwTryWrite(const char *buff, size_t len)
+{
+    if (_hardSerial != nullptr)
+    {
+        int room = _hardSerial->availableForWrite();
+        // Not every core implements availableForWrite. Writing a single byte waits for one character time at most
+        // (unless the module is holding off CTS) and guarantees progress
+        if (room <= 0)
+            room = 1;
+        if ((size_t)room < len)
+            len = room;
+        return _hardSerial->write((const uint8_t *)buff, len);
+    }
+#ifdef UBX_CELL_SOFTWARE_SERIAL_ENABLED
+    else if (_softSerial != nullptr)
+    {
+        return _softSerial->write((const uint8_t *)buff, len); // SoftwareSerial always waits
+    }
+#endif
+    else if (_transport != nullptr)
+    {
+        return _transport->tryWrite(buff, len);
+    }
 
     return (size_t)0;
 }
 
+// Add len bytes to the TX queue. If the queue fills, keep draining it until everything has been queued - or the link
+// has accepted nothing for UBX_CELL_SOCKET_WRITE_TIMEOUT. Returns the number of bytes queued
+size_t SparkFun_ublox_Cellular::txQueueData(const char *buff, size_t len)
+{
+    size_t queued = 0;
+    bool waited = false;
+    unsigned long timeIn = millis();
+
+    while (queued < len)
+    {
+        // Copy as much as will fit. The free space may wrap, so this can take two goes
+        while ((queued < len) && (_txQueueUsed < _txQueueSize))
+        {
+            size_t chunk = _txQueueSize - _txQueueHead; // Contiguous space up to the end of the queue
+            if (chunk > (size_t)(_txQueueSize - _txQueueUsed))
+                chunk = _txQueueSize - _txQueueUsed;
+            if (chunk > (len - queued))
+                chunk = len - queued;
+            memcpy(&_txQueue[_txQueueHead], &buff[queued], chunk);
+            _txQueueHead += chunk;
+            if (_txQueueHead == _txQueueSize)
+                _txQueueHead = 0;
+            _txQueueUsed += chunk;
+            queued += chunk;
+        }
+
+        if (txDrain() > 0)
+            timeIn = millis(); // Still moving
+
+        if (queued < len) // The queue is full
+        {
+            if (!waited)
+            {
+                _txWouldBlock++;
+                waited = true;
+            }
+            if ((millis() - timeIn) >= UBX_CELL_SOCKET_WRITE_TIMEOUT)
+            {
+                if (_printDebug == true)
+                    _debugPort->println(F("txQueueData: the link has stopped accepting data!"));
+                break;
+            }
+            yield();
+        }
+    }
+
+    return queued;
+}
+
+// Hand the link as much of the TX queue as it will take without waiting. Returns the number of bytes sent
+size_t SparkFun_ublox_Cellular::txDrain(void)
+{
+    size_t sent = 0;
+
+    while (_txQueueUsed > 0)
+    {
+        int chunk = _txQueueSize - _txQueueTail; // Contiguous bytes up to the end of the queue
+        if (chunk > _txQueueUsed)
+            chunk = _txQueueUsed;
+        int numWritten = (int)hwTryWrite(&_txQueue[_txQueueTail], chunk);
+        _txQueueTail += numWritten;
+        if (_txQueueTail == _txQueueSize)
+            _txQueueTail = 0;
+        _txQueueUsed -= numWritten;
+        sent += numWritten;
+        if (numWritten < chunk) // The link is full
+        {
+            if (numWritten > 0)
+                _txPartialWrites++;
+            break;
+        }
+    }
+
+    return sent;
+}
+
 int SparkFun_ublox_Cellular::readAvailable(char *inString)
 {
     int len = 0;
 
-    if (_hardSerial != nullptr)
+    // Return any staged bytes first
+    while (_rxStageHead < _rxStageTail)
+    {
+        char c = _rxStage[_rxStageHead++];
+        if (inString != nullptr)
+        {
+            inString[len++] = c;
+        }
+    }
+
+    if (_rxFeed != nullptr)
+    {
+        char c;
+        while (rxFeedRead(&c, 1) == 1)
+        {
+            if (inString != nullptr)
+            {
+                inString[len++] = c;
+            }
+        }
+        if (inString != nullptr)
+        {
+            inString[len] = 0;
+        }
+    }
+    else if (_hardSerial != nullptr)
     {
         while (_hardSerial->available())
         {
@@ -5626,6 +6542,21 @@ int SparkFun_ublox_Cellular::readAvailable(char *inString)
         }
     }
 #endif
+    else if (_transport != nullptr)
+    {
+        char c;
+        while (_transport->read(&c, 1) == 1)
+        {
+            if (inString != nullptr)
+            {
+                inString[len++] = c;
+            }
+        }
+        if (inString != nullptr)
+        {
+            inString[len] = 0;
+        }
+    }
 
     return len;
 }
@@ -5634,7 +6565,15 @@ char SparkFun_ublox_Cellular::readChar(void)
 {
     char ret = 0;
 
-    if (_hardSerial != nullptr)
+    if (_rxStageHead < _rxStageTail) // Return any staged bytes first
+    {
+        ret = _rxStage[_rxStageHead++];
+    }
+    else if (_rxFeed != nullptr)
+    {
+        rxFeedRead(&ret, 1);
+    }
+    else if (_hardSerial != nullptr)
     {
         ret = (char)_hardSerial->read();
     }
@@ -5644,29 +6583,557 @@ char SparkFun_ublox_Cellular::readChar(void)
         ret = (char)_softSerial->read();
     }
 #endif
+    else if (_transport != nullptr)
+    {
+        _transport->read(&ret, 1);
+    }
 
     return ret;
 }
 
 int SparkFun_ublox_Cellular::hwAvailable(void)
 {
-    if (_hardSerial != nullptr)
+    int staged = _rxStageTail - _rxStageHead;
+
+    if (_rxFeed != nullptr)
+    {
+        return rxFeedAvailable() + staged;
+    }
+    else if (_hardSerial != nullptr)
     {
-        return _hardSerial->available();
+        return _hardSerial->available() + staged;
     }
 #ifdef UBX_CELL_SOFTWARE_SERIAL_ENABLED
     else if (_softSerial != nullptr)
     {
-        return _softSerial->available();
+        return _softSerial->available() + staged;
     }
 #endif
+    else if (_transport != nullptr)
+    {
+        int avail = _transport->available();
+        if (avail < 0)
+            return (staged > 0) ? staged : -1;
+        return avail + staged;
+    }
+
+    return (staged > 0) ? staged : -1;
+}
+
+// Read up to len bytes from the serial port in a single call.
+// Only the bytes which are already available are requested, so readBytes never has to wait for its timeout.
+size_t SparkFun_ublox_Cellular::hwReadBytes(char *dest, size_t len)
+{
+    int avail = 0;
+
+    if (_rxFeed != nullptr)
+    {
+        return rxFeedRead(dest, len);
+    }
+    else if (_hardSerial != nullptr)
+    {
+        avail = _hardSerial->available();
+        if (avail <= 0)
+            return (size_t)0;
+        if ((size_t)avail > len)
+            avail = len;
+        return _hardSerial->readBytes(dest, avail);
+    }
+#ifdef UBX_CELL_SOFTWARE_SERIAL_ENABLED
+    else if (_softSerial != nullptr)
+    {
+        avail = _softSerial->available();
+        if (avail <= 0)
+            return (size_t)0;
+        if ((size_t)avail > len)
+            avail = len;
+        return _softSerial->readBytes(dest, avail);
+    }
+#endif
+    else if (_transport != nullptr)
+    {
+        return _transport->read(dest, len); // Transports never wait, so there is no need to check available first
+    }
+
+    return (size_t)0;
+}
+
+// If _rxStage is empty, refill it from the serial port with a single block read.
+// Returns the number of bytes waiting in _rxStage.
+int SparkFun_ublox_Cellular::rxFill(void)
+{
+    if (_rxStageHead >= _rxStageTail)
+    {
+        _rxStageHead = 0;
+        _rxStageTail = (int)hwReadBytes(_rxStage, _RXStageSize);
+    }
+    return _rxStageTail - _rxStageHead;
+}
+
+// Copy up to len bytes into dest: any staged bytes first, then whatever the serial port has available.
+// Returns the number of bytes copied. Does not wait for data.
+int SparkFun_ublox_Cellular::rxRead(char *dest, int len)
+{
+    int numRead = 0;
+
+    if (len <= 0)
+        return 0;
+
+    if (_rxStageHead < _rxStageTail)
+    {
+        numRead = _rxStageTail - _rxStageHead;
+        if (numRead > len)
+            numRead = len;
+        memcpy(dest, &_rxStage[_rxStageHead], numRead);
+        _rxStageHead += numRead;
+    }
+
+    if (numRead < len)
+        numRead += (int)hwReadBytes(&dest[numRead], len - numRead);
+
+    return numRead;
+}
+
+// Read up to len bytes from the RX feed. Never waits
+size_t SparkFun_ublox_Cellular::rxFeedRead(char *dest, size_t len)
+{
+    uint16_t head = __atomic_load_n(&_rxFeedHead, __ATOMIC_ACQUIRE);
+    uint16_t tail = _rxFeedTail;
+    size_t numRead = 0;
+
+    while ((numRead < len) && (tail != head))
+    {
+        // Copy the contiguous part: up to head, or up to the end of the buffer if head has wrapped
+        size_t chunk = (head > tail) ? (head - tail) : (_rxFeedSize - tail);
+        if (chunk > (len - numRead))
+            chunk = len - numRead;
+        memcpy(&dest[numRead], &_rxFeed[tail], chunk);
+        numRead += chunk;
+        tail += chunk;
+        if (tail == _rxFeedSize)
+            tail = 0;
+    }
+
+    __atomic_store_n(&_rxFeedTail, tail, __ATOMIC_RELEASE);
+    return numRead;
+}
+
+int SparkFun_ublox_Cellular::rxFeedAvailable(void)
+{
+    uint16_t head = __atomic_load_n(&_rxFeedHead, __ATOMIC_ACQUIRE);
+    uint16_t tail = _rxFeedTail;
+    return (head >= tail) ? (head - tail) : (_rxFeedSize - tail + head);
+}
+
+// Every response and error the driver waits for ends with a fixed character, usually '\n'. feedRx only needs to wake
+// the waiter when one of these arrives
+void SparkFun_ublox_Cellular::rxWaitFor(const char *expectedResponse, const char *expectedError)
+{
+    char wakeResponse = '\n';
+    char wakeError = '\n';
+    if ((expectedResponse != nullptr) && (expectedResponse[0] != '\0'))
+        wakeResponse = expectedResponse[strlen(expectedResponse) - 1];
+    if ((expectedError != nullptr) && (expectedError[0] != '\0'))
+        wakeError = expectedError[strlen(expectedError) - 1];
+    _rxWakeResponse = wakeResponse;
+    _rxWakeError = wakeError;
+}
 
-    return -1;
+// Called when there is nothing to read. With the RX feed, sleep until feedRx signals that the response may have
+// arrived. Otherwise just yield and poll again
+void SparkFun_ublox_Cellular::rxWait(unsigned long maxMillis)
+{
+    if ((maxMillis > 0) && (nullptr != _rxFeed) && (nullptr != _rxWaitCallback) && (rxFeedAvailable() == 0) && (_txQueueUsed == 0))
+        _rxWaitCallback(maxMillis);
+    else
+        yield();
+}
+
+// Empty the RX ring and its event index
+void SparkFun_ublox_Cellular::rxRingReset(void)
+{
+    _rxRingHead = 0;
+    _rxRingTail = 0;
+    _rxRingUsed = 0;
+    _rxLineLength = 0;
+    _rxEventFirst = 0;
+    _rxEventCount = 0;
+    _rxEventKept = 0;
+    _rxLastChar = '\n';
+    _rxLinePayload = false;
+    _rxPayloadRemaining = 0;
+    _rxField = -1;
+    _rxLastField = -1;
+}
+
+// If the ring is full and holds no complete events, it is full of a partial line which will never be processed.
+// Discard it so reception can continue. Returns true if there is now room in the ring.
+bool SparkFun_ublox_Cellular::rxRingMakeRoom(void)
+{
+    if (_rxRingUsed < _RXBuffSize)
+        return true;
+
+    if (_rxEventCount > 0)
+        return false;
+
+    if (_printDebug == true)
+        _debugPort->println(F("rxRingMakeRoom: ring is full of a partial line. Discarding it"));
+
+    // Keep track of a binary payload, so the rest of it is not mistaken for lines
+    bool linePayload = _rxLinePayload;
+    int payloadRemaining = _rxPayloadRemaining;
+    rxRingReset();
+    _rxLinePayload = linePayload;
+    _rxPayloadRemaining = payloadRemaining;
+    return true;
+}
+
+// Drain whatever the serial port has available straight into the free space of the ring, then index it.
+// No more is read than the event index can take: anything else is left in the serial port until bufferedPoll has
+// processed some events, rather than being stored and never indexed. Returns the number of bytes added.
+int SparkFun_ublox_Cellular::rxRingFill(void)
+{
+    int total = 0;
+
+    for (int pass = 0; pass < 2; pass++) // Up to the physical end of the ring, then on from the start
+    {
+        if (rxRingMakeRoom() == false)
+            break;
+
+        int space = _RXBuffSize - _rxRingHead; // Contiguous space
+        if (space > _RXBuffSize - _rxRingUsed)
+            space = _RXBuffSize - _rxRingUsed;
+
+        // At most two events end in any three bytes: a one character line, its delimiter and a prompt
+        int eventSpace = (3 * (_RXMaxEvents - _rxEventCount - 1)) / 2;
+        if (space > eventSpace)
+            space = eventSpace;
+        if (space <= 0)
+            break;
+
+        int numRead = rxRead(&_rxRing[_rxRingHead], space);
+        if (numRead <= 0)
+            break;
+
+        rxRingCommit(numRead);
+        total += numRead;
+    }
+
+    return total;
+}
+
+// Append a single byte to the ring. Returns false if the ring is full and the byte was dropped.
+bool SparkFun_ublox_Cellular::rxRingPut(char c)
+{
+    if (rxRingMakeRoom() == false)
+    {
+        if (_rxPayloadRemaining > 0) // Keep count, so the end of the payload is still found
+            _rxPayloadRemaining--;
+        return false;
+    }
+
+    _rxRing[_rxRingHead] = c;
+    rxRingCommit(1);
+    return true;
+}
+
+// Account for the len bytes which have just been written at _rxRingHead.
+// Only these new bytes are tokenized, one at a time:
+// - each \r or \n which ends a non-empty line adds that line to the event index
+// - a > or @ at the start of a line is a data prompt. It is indexed straight away, as nothing follows it
+// - a response which carries binary data (+USORD: 0,5,"hello") is recognised at the quote which follows its length.
+//   The next length bytes (2 * length hex digits for socket data in hex mode) are payload: line ends and NULs in them
+//   are data. The whole line is one payload event
+// - each line which is a final result code (OK, ERROR, +CME ERROR: <n> ...) is noted in _rxResultCode
+// While a command is waiting for its response, only URCs are kept. Anything else is dropped as soon as it is complete,
+// by stepping _rxRingHead back over it, so pruneBacklog has nothing left to do afterwards
+void SparkFun_ublox_Cellular::rxRingCommit(int len)
+{
+    int src = _rxRingHead; // Where the new bytes are. Behind _rxRingHead once anything has been dropped
+    int width;
+    for (int i = 0; i < len; i++)
+    {
+        char c = _rxRing[src];
+        src = (src + 1) % _RXBuffSize;
+        _rxRing[_rxRingHead] = c;
+        _rxRingHead = (_rxRingHead + 1) % _RXBuffSize;
+        _rxRingUsed++;
+
+        if (_rxPayloadRemaining > 0)
+        {
+            _rxPayloadRemaining--;
+            _rxLineLength++;
+        }
+        else if ((c == '\r') || (c == '\n'))
+        {
+            if (_rxLineLength > 0)
+            {
+                int start = (_rxRingHead - 1 - _rxLineLength + (2 * _RXBuffSize)) % _RXBuffSize;
+                if (!_rxLinePayload)
+                    rxRingCheckResult(start, _rxLineLength);
+                if (_rxCommandActive &&
+                    (_rxLinePayload || !urcIndexSearch(_rxRing, _RXBuffSize, start, _rxLineLength, nullptr)))
+                    rxRingDrop(_rxLineLength + 1); // Part of the response. The command has already seen it
+                else
+                    rxRingAddEvent(start, _rxLineLength,
+                                   _rxLinePayload ? UBX_CELL_RX_EVENT_PAYLOAD : UBX_CELL_RX_EVENT_LINE);
+            }
+            else if (_rxCommandActive)
+            {
+                rxRingDrop(1); // The \n of a \r\n
+            }
+            _rxLineLength = 0;
+            _rxLinePayload = false;
+            _rxField = -1;
+            _rxLastField = -1;
+        }
+        else if (((c == '>') || (c == '@')) && (_rxLineLength == 0) && (_rxLastChar == '\n'))
+        {
+            if (_rxCommandActive)
+                rxRingDrop(1);
+            else
+                rxRingAddEvent((_rxRingHead - 1 + _RXBuffSize) % _RXBuffSize, 1, UBX_CELL_RX_EVENT_PROMPT);
+        }
+        else
+        {
+            if (c == ',')
+            {
+                _rxLastField = _rxField;
+                _rxField = 0;
+            }
+            else if ((c >= '0') && (c <= '9') && (_rxField >= 0) && (_rxField < 0x10000))
+            {
+                _rxField = (_rxField * 10) + (c - '0');
+            }
+            else if ((c == '\"') && (_rxLastChar == ',') && (_rxLastField > 0) && (!_rxLinePayload) &&
+                     ((width = rxRingPayloadWidth()) > 0))
+            {
+                _rxLinePayload = true;
+                _rxPayloadRemaining = (int)_rxLastField * width;
+            }
+            else
+            {
+                _rxField = -1;
+            }
+            _rxLineLength++;
+        }
+
+        _rxLastChar = c;
+    }
+}
+
+// Add an event to the index
+void SparkFun_ublox_Cellular::rxRingAddEvent(int start, int length, UBX_CELL_rx_event_type_t type)
+{
+    if (_rxEventCount == _RXMaxEvents)
+        rxRingMergeEvents();
+
+    if (_rxEventCount < _RXMaxEvents)
+    {
+        UBX_CELL_rx_event_t *event = &_rxEvents[(_rxEventFirst + _rxEventCount) % _RXMaxEvents];
+        event->start = start;
+        event->length = length;
+        event->type = type;
+        if (_rxCommandActive && (_rxEventKept == _rxEventCount))
+            _rxEventKept++; // Only URCs are added while a command is active. There is no need to prune it later
+        _rxEventCount++;
+    }
+    else
+    {
+        // The event stays in the ring but is never indexed. rxRingPop and pruneBacklog step over it
+        if (_printDebug == true)
+            _debugPort->println(F("rxRingAddEvent: event index is full! Dropping event"));
+    }
+}
+
+// The event index is full. Make room by merging each run of neighbouring URC lines into one event. Only events
+// known to be wanted are merged, so pruneBacklog never sees a merged event. The oldest event is left alone:
+// bufferedPoll or poll may be processing it. Each merged event must still fit the slack when it wraps, so rxRingFront
+// can unwrap it. processURCLines splits the lines up again. Returns true if any entries were freed
+bool SparkFun_ublox_Cellular::rxRingMergeEvents(void)
+{
+    int merged = 0;
+    int dest = 1; // Where the next event goes. The oldest event stays where it is
+
+    for (int i = 1; i < _rxEventCount; i++)
+    {
+        UBX_CELL_rx_event_t event = _rxEvents[(_rxEventFirst + i) % _RXMaxEvents];
+        UBX_CELL_rx_event_t *last = &_rxEvents[(_rxEventFirst + dest - 1) % _RXMaxEvents];
+
+        if ((dest > 1) && (i < _rxEventKept) && (last->type == UBX_CELL_RX_EVENT_LINE) &&
+            (event.type == UBX_CELL_RX_EVENT_LINE))
+        {
+            int lastEnd = (last->start + last->length) % _RXBuffSize;
+            int gap = (event.start - lastEnd + _RXBuffSize) % _RXBuffSize;
+            int length = last->length + gap + event.length;
+            bool delimiters = true; // Only line ends between the two lines
+            for (int j = 0; (j < gap) && delimiters; j++)
+            {
+                char c = _rxRing[(lastEnd + j) % _RXBuffSize];
+                delimiters = (c == '\r') || (c == '\n');
+            }
+            if (delimiters && (length < _RXEventSlack))
+            {
+                last->length = length;
+                merged++;
+                continue;
+            }
+        }
+
+        _rxEvents[(_rxEventFirst + dest) % _RXMaxEvents] = event;
+        dest++;
+    }
+
+    _rxEventCount -= merged;
+    _rxEventKept -= merged;
+    return merged > 0;
+}
+
+// Discard the newest len bytes of the ring
+void SparkFun_ublox_Cellular::rxRingDrop(int len)
+{
+    _rxRingHead = (_rxRingHead - len + _RXBuffSize) % _RXBuffSize;
+    _rxRingUsed -= len;
+}
+
+// Check if the current (partial) line starts with one of the responses which carry binary data. Returns the number
+// of characters each byte of its payload takes: 2 for socket data in hex mode, else 1. Or 0 if it carries none
+int SparkFun_ublox_Cellular::rxRingPayloadWidth(void)
+{
+    static const char *const payloadResponses[] = {UBX_CELL_READ_SOCKET, UBX_CELL_READ_UDP_SOCKET,
+                                                   UBX_CELL_FILE_SYSTEM_READ_FILE, UBX_CELL_FILE_SYSTEM_READ_BLOCK};
+    int lineStart = (_rxRingHead - 1 - _rxLineLength + (2 * _RXBuffSize)) % _RXBuffSize; // The quote is not counted yet
+
+    for (size_t r = 0; r < sizeof(payloadResponses) / sizeof(payloadResponses[0]); r++)
+    {
+        int len = (int)strlen(payloadResponses[r]);
+        if (_rxLineLength <= len)
+            continue;
+        int j = 0;
+        while ((j < len) && (_rxRing[(lineStart + j) % _RXBuffSize] == payloadResponses[r][j]))
+            j++;
+        if ((j == len) && (_rxRing[(lineStart + len) % _RXBuffSize] == ':'))
+            return ((r < 2) && _socketHexMode) ? 2 : 1; // The first two are the socket reads
+    }
+
+    return 0;
+}
+
+// Check if the complete line at start is a final result code. If it is, note it in _rxResultCode and _rxResultCause
+// so the command in progress can end without waiting for its timeout. The dial result codes (NO CARRIER...) only
+// count while the command is ATD
+void SparkFun_ublox_Cellular::rxRingCheckResult(int start, int length)
+{
+    static const char *const results[] = {"OK", "ERROR", "+CME ERROR:", "+CMS ERROR:", "NO CARRIER", "BUSY",
+                                          "NO ANSWER", "NO DIALTONE"};
+    static const UBX_CELL_result_code_t codes[] = {UBX_CELL_RESULT_OK,         UBX_CELL_RESULT_ERROR,
+                                                   UBX_CELL_RESULT_CME_ERROR,  UBX_CELL_RESULT_CMS_ERROR,
+                                                   UBX_CELL_RESULT_NO_CARRIER, UBX_CELL_RESULT_BUSY,
+                                                   UBX_CELL_RESULT_NO_ANSWER,  UBX_CELL_RESULT_NO_DIALTONE};
+
+    // Every result code starts with one of these. Most lines can be rejected on their first character
+    char first = _rxRing[start];
+    if ((first != 'O') && (first != 'E') && (first != '+') && (first != 'N') && (first != 'B'))
+        return;
+
+    size_t numResults = _rxDialing ? sizeof(results) / sizeof(results[0]) : 4;
+    for (size_t r = 0; r < numResults; r++)
+    {
+        int len = (int)strlen(results[r]);
+        bool prefix = (results[r][len - 1] == ':'); // +CME ERROR: and +CMS ERROR: are followed by the cause
+        if ((length < len) || ((!prefix) && (length != len)))
+            continue;
+        int j = 0;
+        while ((j < len) && (_rxRing[(start + j) % _RXBuffSize] == results[r][j]))
+            j++;
+        if (j < len)
+            continue;
+
+        _rxResultCode = codes[r];
+        _rxResultCause = -1;
+        if (prefix)
+        {
+            while ((j < length) && (_rxRing[(start + j) % _RXBuffSize] == ' '))
+                j++;
+            while ((j < length) && (_rxRing[(start + j) % _RXBuffSize] >= '0') &&
+                   (_rxRing[(start + j) % _RXBuffSize] <= '9') && (_rxResultCause < 10000))
+            {
+                _rxResultCause = ((_rxResultCause < 0) ? 0 : (_rxResultCause * 10)) +
+                                 (_rxRing[(start + j) % _RXBuffSize] - '0');
+                j++;
+            }
+        }
+        return;
+    }
+}
+
+// Return the oldest line or payload event as a C string. The delimiter which follows it in the ring is overwritten with a NULL,
+// so normally no copy is needed. An event which wraps around the end of the ring has its wrapped part copied into the
+// slack after the end. The pointer is valid until rxRingPop.
+char *SparkFun_ublox_Cellular::rxRingFront(void)
+{
+    UBX_CELL_rx_event_t *event = &_rxEvents[_rxEventFirst];
+    int end = event->start + event->length;
+
+    if (end < _RXBuffSize)
+    {
+        _rxRing[end] = '\0';
+    }
+    else
+    {
+        int wrapped = end - _RXBuffSize;
+        if (wrapped >= _RXEventSlack)
+        {
+            if (_printDebug == true)
+                _debugPort->println(F("rxRingFront: event is too long to unwrap! Truncating it"));
+            wrapped = _RXEventSlack - 1;
+        }
+        memcpy(&_rxRing[_RXBuffSize], _rxRing, wrapped);
+        _rxRing[_RXBuffSize + wrapped] = '\0';
+    }
+
+    return &_rxRing[event->start];
+}
+
+// Discard the oldest event, and anything before it
+void SparkFun_ublox_Cellular::rxRingPop(void)
+{
+    if (_rxEventCount == 0)
+        return;
+
+    UBX_CELL_rx_event_t *event = &_rxEvents[_rxEventFirst];
+    int delimiter = (event->type == UBX_CELL_RX_EVENT_PROMPT) ? 0 : 1;
+    _rxRingTail = (event->start + event->length + delimiter) % _RXBuffSize; // Step over the event and its delimiter
+    _rxEventFirst = (_rxEventFirst + 1) % _RXMaxEvents;
+    _rxEventCount--;
+    if (_rxEventKept > 0)
+        _rxEventKept--;
+
+    if (_rxEventCount == 0) // Only delimiters and maybe a partial line are left. Drop the delimiters
+        _rxRingTail = (_rxRingHead - _rxLineLength + _RXBuffSize) % _RXBuffSize;
+
+    _rxRingUsed = (_rxRingHead - _rxRingTail + _RXBuffSize) % _RXBuffSize;
+}
+
+// Move len bytes from ring index src to ring index dest. dest must not be ahead of src
+void SparkFun_ublox_Cellular::rxRingMove(int dest, int src, int len)
+{
+    if (dest == src)
+        return;
+
+    for (int i = 0; i < len; i++)
+        _rxRing[(dest + i) % _RXBuffSize] = _rxRing[(src + i) % _RXBuffSize];
 }
 
 void SparkFun_ublox_Cellular::beginSerial(unsigned long baud)
 {
     delay(100);
+    hwBegin(baud);
+    delay(100);
+}
+
+void SparkFun_ublox_Cellular::hwBegin(unsigned long baud)
+{
     if (_hardSerial != nullptr)
     {
         _hardSerial->end();
@@ -5679,7 +7146,57 @@ void SparkFun_ublox_Cellular::beginSerial(unsigned long baud)
         _softSerial->begin(baud);
     }
 #endif
-    delay(100);
+    else if (_transport != nullptr)
+    {
+        _transport->end();
+        _transport->begin(baud);
+    }
+}
+
+void SparkFun_ublox_Cellular::switchBaud(unsigned long baud)
+{
+    txFlush(UBX_CELL_SOCKET_WRITE_TIMEOUT); // Anything queued must go at the old rate
+    hwBegin(baud);
+    delay(UBX_CELL_BAUD_SETTLE_MILLIS);
+    readAvailable(nullptr); // Discard anything which arrived while the rates did not match
+}
+
+// Send UBX_CELL_BAUD_PROBE_COUNT +IPR? commands and check each response reports baud (or 0: autobauding).
+// Any missing or corrupt response fails the probe. Returns the measured throughput in bytes per second
+UBX_CELL_error_t SparkFun_ublox_Cellular::probeBaud(unsigned long baud, unsigned long *throughput)
+{
+    UBX_CELL_error_t err;
+    size_t cmdLen = strlen(UBX_CELL_COMMAND_BAUD) + 2;
+    char command[cmdLen];
+    char response[minimumResponseAllocation];
+    unsigned long bytes = 0;
+
+    snprintf(command, cmdLen, "%s?", UBX_CELL_COMMAND_BAUD);
+
+    unsigned long timeIn = micros();
+    for (int i = 0; i < UBX_CELL_BAUD_PROBE_COUNT; i++)
+    {
+        memset(response, 0, minimumResponseAllocation);
+        err = sendCommandWithResponse(command, UBX_CELL_RESPONSE_OK_OR_ERROR, response, UBX_CELL_BAUD_PROBE_TIMEOUT,
+                                      minimumResponseAllocation);
+        if (err != UBX_CELL_ERROR_SUCCESS)
+            return err;
+
+        unsigned long reported = 1; // Anything but baud or 0
+        char *searchPtr = strnstr(response, "+IPR:", minimumResponseAllocation);
+        if (searchPtr != nullptr)
+            sscanf(searchPtr + strlen("+IPR:"), "%lu", &reported);
+        if ((reported != baud) && (reported != 0))
+            return UBX_CELL_ERROR_UNEXPECTED_RESPONSE;
+
+        bytes += strlen(UBX_CELL_COMMAND_AT) + strlen(command) + 2 + strlen(response);
+    }
+    unsigned long elapsed = micros() - timeIn;
+
+    if (elapsed == 0)
+        elapsed = 1;
+    *throughput = (unsigned long)(((unsigned long long)bytes * 1000000ULL) / elapsed);
+    return UBX_CELL_ERROR_SUCCESS;
 }
 
 void SparkFun_ublox_Cellular::setTimeout(unsigned long timeout)
@@ -5738,65 +7255,55 @@ char *SparkFun_ublox_Cellular::ubx_cell_calloc_char(size_t num)
 
 // This prunes the backlog of non-actionable events. If new actionable events are added, you must modify the if
 // statement.
+// The events which are already known to be wanted (kept by an earlier prune, or being processed by bufferedPoll) are
+// skipped. The rest are checked once each. The ones we keep are slid down the ring over the ones we drop, along with
+// any partial line which follows them. Nothing is copied out of the ring and the ring is never cleared.
+// While a command is active, rxRingCommit prunes each line as it completes, so a long response never builds up in the
+// ring. This is only left with whatever arrived before the command.
 void SparkFun_ublox_Cellular::pruneBacklog()
 {
-    char *event;
-
-    // if (_printDebug == true)
-    // {
-    //   if (_saraResponseBacklogLength > 0) //Handy for debugging new parsing.
-    //   {
-    //     _debugPort->println(F("pruneBacklog: before pruning, backlog was:"));
-    //     _debugPort->println(_saraResponseBacklog);
-    //     _debugPort->println(F("pruneBacklog: end of backlog"));
-    //   }
-    //   else
-    //   {
-    //     _debugPort->println(F("pruneBacklog: backlog was empty"));
-    //   }
-    // }
+    if (_rxEventKept >= _rxEventCount)
+        return; // Nothing new to prune
 
-    memset(_pruneBuffer, 0, _RXBuffSize); // Clear the _pruneBuffer
+    int regionStart = _rxEvents[(_rxEventFirst + _rxEventKept) % _RXMaxEvents].start;
+    int regionLength = _rxRingUsed - ((regionStart - _rxRingTail + _RXBuffSize) % _RXBuffSize);
+    int dest = regionStart;
+    int keptLength = 0;
+    int kept = _rxEventKept;
 
-    _saraResponseBacklogLength = 0; // Zero the backlog length
+    for (int i = _rxEventKept; i < _rxEventCount; i++)
+    {
+        UBX_CELL_rx_event_t event = _rxEvents[(_rxEventFirst + i) % _RXMaxEvents];
 
-    char *preservedEvent;
-    event = strtok_r(_saraResponseBacklog, "\r\n", &preservedEvent); // Look for an 'event' - something ending in \r\n
+        // Prompts and payloads are only ever part of a response. Binary data must not be mistaken for a URC
+        if (event.type != UBX_CELL_RX_EVENT_LINE)
+            continue;
 
-    while (event != nullptr) // If event is actionable, add it to pruneBuffer.
-    {
         // These are the events we want to keep so they can be processed by poll / bufferedPoll
-        for (auto urcString : _urcStrings)
+        if (urcIndexSearch(_rxRing, _RXBuffSize, event.start, event.length, nullptr))
         {
-            if (strnstr(event, urcString, _RXBuffSize - (event - _saraResponseBacklog)) != nullptr)
-            {
-                strcat(_pruneBuffer, event);  // The URCs are all readable text so using strcat is OK
-                strcat(_pruneBuffer, "\r\n"); // strtok blows away delimiter, but we want that for later.
-                _saraResponseBacklogLength +=
-                    strlen(event) + 2; // Add the length of this event to _saraResponseBacklogLength
-                break;                 // No need to check any other events
-            }
+            rxRingMove(dest, event.start, event.length + 1); // Keep the delimiter too
+            UBX_CELL_rx_event_t *keptEvent = &_rxEvents[(_rxEventFirst + kept) % _RXMaxEvents];
+            keptEvent->start = dest;
+            keptEvent->length = event.length;
+            keptEvent->type = UBX_CELL_RX_EVENT_LINE;
+            kept++;
+            keptLength += event.length + 1;
+            dest = (dest + event.length + 1) % _RXBuffSize;
         }
-
-        event = strtok_r(nullptr, "\r\n", &preservedEvent); // Walk though any remaining events
     }
 
-    memset(_saraResponseBacklog, 0, _RXBuffSize); // Clear out backlog buffer.
-    memcpy(_saraResponseBacklog, _pruneBuffer,
-           _saraResponseBacklogLength); // Copy the pruned buffer back into the backlog
+    // Slide any partial line down behind the kept events
+    rxRingMove(dest, (_rxRingHead - _rxLineLength + _RXBuffSize) % _RXBuffSize, _rxLineLength);
+    _rxRingHead = (dest + _rxLineLength) % _RXBuffSize;
+    _rxRingUsed = _rxRingUsed - regionLength + keptLength + _rxLineLength;
+    _rxEventCount = kept;
+    _rxEventKept = kept;
 
     // if (_printDebug == true)
     // {
-    //   if (_saraResponseBacklogLength > 0) //Handy for debugging new parsing.
-    //   {
-    //     _debugPort->println(F("pruneBacklog: after pruning, backlog is now:"));
-    //     _debugPort->println(_saraResponseBacklog);
-    //     _debugPort->println(F("pruneBacklog: end of backlog"));
-    //   }
-    //   else
-    //   {
-    //     _debugPort->println(F("pruneBacklog: backlog is now empty"));
-    //   }
+    //   _debugPort->print(F("pruneBacklog: events kept: ")); //Handy for debugging new parsing.
+    //   _debugPort->println(_rxEventCount);
     // }
 }
 
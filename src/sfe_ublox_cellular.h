@@ -72,6 +72,14 @@
 #include <IPAddress.h>
 #include <vector>
 
+#include "sfe_ublox_cellular_arena.h"
+#include "sfe_ublox_cellular_cmux.h"
+#include "sfe_ublox_cellular_command.h"
+#include "sfe_ublox_cellular_hex.h"
+#include "sfe_ublox_cellular_matcher.h"
+#include "sfe_ublox_cellular_parser.h"
+#include "sfe_ublox_cellular_transport.h"
+
 #define UBX_CELL_POWER_PIN -1 // Default to no pin
 #define UBX_CELL_RESET_PIN -1
 
@@ -131,6 +139,7 @@ const char *const UBX_CELL_DELETE_MESSAGE = "+CMGD";     // Delete message
 // V24 control and V25ter (UART interface)
 const char *const UBX_CELL_FLOW_CONTROL = "&K";   // Flow control
 const char *const UBX_CELL_COMMAND_BAUD = "+IPR"; // Baud rate
+const char *const UBX_CELL_COMMAND_CMUX = "+CMUX"; // Multiplexing mode
 // ### Packet switched data services
 const char *const UBX_CELL_MESSAGE_PDP_DEF = "+CGDCONT"; // Packet switched Data Profile context definition
 const char *const UBX_CELL_MESSAGE_PDP_CONTEXT_ACTIVATE =
@@ -207,6 +216,8 @@ const char *const UBX_CELL_RESPONSE_MORE = "\n>";
 const char *const UBX_CELL_RESPONSE_OK = "\nOK\r\n";
 const char *const UBX_CELL_RESPONSE_ERROR = "\nERROR\r\n";
 const char *const UBX_CELL_RESPONSE_CONNECT = "\r\nCONNECT\r\n";
+const char *const UBX_CELL_RESPONSE_NO_CARRIER = "\r\nNO CARRIER\r\n";
+const char *const UBX_CELL_RESPONSE_DISCONNECT = "\r\nDISCONNECT\r\n";
 #define UBX_CELL_RESPONSE_OK_OR_ERROR nullptr
 
 // URC handler type definition
@@ -226,12 +237,31 @@ const char ASCII_ESC = 0x1B;
 // This needs to be large enough to hold the response you're expecting plus and URC's that may arrive during the timeout
 #define minimumResponseAllocation 128
 
+// Commands are built in a buffer of this size, with no heap. It holds the longest command the driver sends: an MQTT
+// publish of MAX_MQTT_DIRECT_MSG_LEN characters, plus its topic. Longer commands fail with UBX_CELL_ERROR_OUT_OF_MEMORY
+#define UBX_CELL_COMMAND_BUFFER_SIZE 1280
+
 #define UBX_CELL_NUM_SOCKETS 6
 
-#define NUM_SUPPORTED_BAUD 6
-const unsigned long UBX_CELL_SUPPORTED_BAUD[NUM_SUPPORTED_BAUD] = {115200, 9600, 19200, 38400, 57600, 230400};
+#define NUM_SUPPORTED_BAUD 8
+const unsigned long UBX_CELL_SUPPORTED_BAUD[NUM_SUPPORTED_BAUD] = {115200, 9600,   19200,  38400,
+                                                                   57600,  230400, 460800, 921600};
 #define UBX_CELL_DEFAULT_BAUD_RATE 115200
 
+// Baud rate negotiation
+#define UBX_CELL_BAUD_PROBE_COUNT 8     // The number of +IPR? round trips used to qualify each baud rate
+#define UBX_CELL_BAUD_PROBE_TIMEOUT 100 // Millis to wait for each probe (and each detection AT) response
+#define UBX_CELL_BAUD_SETTLE_MILLIS 20  // Millis to let the UARTs settle after a baud rate change
+
+#define UBX_CELL_TX_QUEUE_SIZE 1024 // Default size of the buffer enableTxQueue allocates. Maximum 32768
+#define UBX_CELL_RX_FEED_SIZE 1024 // Default size of the buffer enableRxFeed allocates. Maximum 32768
+// Default size of the response arena begin allocates. Enough for a 1 KB file (the data plus the +URDFILE response it
+// is read from), or the data of a full socket read. Larger reads use the heap, unless setArenaSize makes room
+#define UBX_CELL_ARENA_SIZE 2560
+#define UBX_CELL_PROMPT_DELAY 50 // Millis between a data prompt (@ or >) and the data, as the u-blox specification says
+#define UBX_CELL_SOCKET_WRITE_BUFFER_SIZE 512 // Default size of the buffer setSocketWriteBuffer allocates. Max 1024
+#define UBX_CELL_SOCKET_WRITE_DELAY 20        // Default millis setSocketWriteBuffer holds data before sending it
+
 // Flow control definitions for AT&K
 // Note: SW (XON/XOFF) flow control is not supported on the UBX_CELL
 typedef enum
@@ -278,10 +308,46 @@ typedef enum
     UBX_CELL_ERROR_NO_RESPONSE,         // 5
     UBX_CELL_ERROR_DEREGISTERED,        // 6
     UBX_CELL_ERROR_ZERO_READ_LENGTH,    // 7
-    UBX_CELL_ERROR_ERROR                // 8
+    UBX_CELL_ERROR_ERROR,               // 8
+    UBX_CELL_ERROR_IN_PROGRESS          // 9 - an asynchronous command has not completed yet
 } UBX_CELL_error_t;
 #define UBX_CELL_SUCCESS UBX_CELL_ERROR_SUCCESS
 
+// The final result code which ended a command (3GPP TS 27.007)
+typedef enum
+{
+    UBX_CELL_RESULT_NONE = 0,  // No final result code: a command-specific response matched, or nothing arrived
+    UBX_CELL_RESULT_OK,        // OK
+    UBX_CELL_RESULT_ERROR,     // ERROR
+    UBX_CELL_RESULT_CME_ERROR, // +CME ERROR: <n> - a mobile equipment, SIM or network error
+    UBX_CELL_RESULT_CMS_ERROR, // +CMS ERROR: <n> - a message service error
+    UBX_CELL_RESULT_NO_CARRIER,
+    UBX_CELL_RESULT_BUSY,
+    UBX_CELL_RESULT_NO_ANSWER,
+    UBX_CELL_RESULT_NO_DIALTONE
+} UBX_CELL_result_code_t;
+
+// The outcome of the last command, in more detail than UBX_CELL_error_t
+typedef struct
+{
+    UBX_CELL_error_t error;      // What waitForResponse or sendCommandWithResponse returned
+    UBX_CELL_result_code_t code; // The final result code the module sent
+    int cause;                   // The <n> of +CME ERROR or +CMS ERROR. -1 if there was none, or it was text (+CMEE=2)
+} UBX_CELL_result_t;
+
+// Identifies an asynchronous command (see sendCommandAsync). Never 0
+typedef uint16_t UBX_CELL_command_handle_t;
+#define UBX_CELL_COMMAND_HANDLE_INVALID 0
+
+// Called when an asynchronous command completes: its handle, its result and its response (nullptr if there was no
+// response buffer). The response is only valid during the call
+typedef void (*UBX_CELL_command_callback_t)(UBX_CELL_command_handle_t handle, UBX_CELL_error_t result,
+                                            const char *response);
+
+// Called when getOperatorsAsync completes: its handle, its result and how many operators it stored
+typedef void (*UBX_CELL_operators_callback_t)(UBX_CELL_command_handle_t handle, UBX_CELL_error_t result,
+                                              uint8_t numOps);
+
 typedef enum
 {
     UBX_CELL_REGISTRATION_INVALID = -1,
@@ -629,6 +695,8 @@ typedef enum
     // DEEP_LOW_POWER_STATE = 127 // Not supported on SARA-R5
 } UBX_CELL_functionality_t;
 
+class SparkFun_ublox_Cellular_Client;
+
 class SparkFun_ublox_Cellular : public Print
 {
   public:
@@ -643,6 +711,8 @@ class SparkFun_ublox_Cellular : public Print
     bool begin(SoftwareSerial &softSerial, unsigned long baud = UBX_CELL_DEFAULT_BAUD_RATE);
 #endif
     bool begin(HardwareSerial &hardSerial, unsigned long baud = UBX_CELL_DEFAULT_BAUD_RATE);
+    // Use any other link to the module, e.g. SparkFun_ublox_Cellular_Transport_POSIX on a Linux host
+    bool begin(SparkFun_ublox_Cellular_Transport &transport, unsigned long baud = UBX_CELL_DEFAULT_BAUD_RATE);
 
     // Debug prints
     void enableDebugging(
@@ -650,6 +720,28 @@ class SparkFun_ublox_Cellular : public Print
     void enableAtDebugging(
         Print &debugPort = Serial); // Turn on AT debug printing. If user doesn't specify then Serial will be used.
 
+    // The final result code of the last command, with the +CME ERROR / +CMS ERROR cause. Use +CMEE=1 for numeric causes
+    UBX_CELL_result_t getLastResult(void);
+
+    // Response arena
+    // Response and temporary buffers (file contents, socket and MQTT reads, operator lists...) come from a fixed block
+    // allocated by begin, not the heap. A response which does not fit (a large file or socket read) comes from the heap
+    // instead, and counts as an arena failure.
+    // Call setArenaSize before begin, or at any time no command is in progress, to change its size
+    bool setArenaSize(size_t size);
+    size_t arenaSize(void)
+    {
+        return _arena.size();
+    }
+    size_t arenaHighWater(void) // The most of the arena that has been in use at once. Use it to size the arena
+    {
+        return _arena.highWater();
+    }
+    uint32_t arenaFailures(void) // The number of buffers which did not fit, and came from the heap
+    {
+        return _arena.failures();
+    }
+
     // Invert the polarity of the power pin - if required
     // Normally the SARA's power pin is pulled low and released to toggle the power
     // But the Asset Tracker needs this to be pulled high and released instead
@@ -673,6 +765,43 @@ class SparkFun_ublox_Cellular : public Print
     // Retained for backward-compatibility and just in case you do want to (temporarily) ignore any data in the backlog
     bool poll(void);
 
+    // TX queue
+    // Data payloads (socket writes, file downloads etc.) are queued and drained as the link accepts them, while the
+    // driver carries on reading responses and URCs, instead of blocking inside the serial write. This helps most with
+    // hardware flow control (setFlowControl), where the module can hold off the UART for long periods.
+    // Commands are never queued, but they wait for any queued data to be sent first.
+    bool enableTxQueue(size_t size = UBX_CELL_TX_QUEUE_SIZE);
+    void disableTxQueue(void);                   // Flushes the queue first
+    size_t txQueued(void);                       // The number of bytes waiting to be sent
+    size_t txFree(void);                         // The number of bytes which can be queued without waiting
+    bool txFlush(unsigned long timeout);         // Wait up to timeout millis for the queue to empty
+    uint32_t txWouldBlock(void)                  // The number of writes which found the queue full and had to wait
+    {
+        return _txWouldBlock;
+    }
+    uint32_t txPartialWrites(void)               // The number of times the link accepted some, not all, of a write
+    {
+        return _txPartialWrites;
+    }
+
+    // Interrupt / callback driven RX
+    // Instead of the driver polling the serial port, the platform's UART RX interrupt (or a reader thread on a host)
+    // pushes the received bytes in with feedRx. While a command waits for its response, the driver calls waitFn
+    // instead of spinning. feedRx calls notifyFn - in the producer's context - when the last character of the expected
+    // response or error arrives, or when the feed is three quarters full.
+    // waitFn(maxMillis) should sleep until notified, or for maxMillis at most. A notification which arrives before
+    // waitFn is called must not be lost: use a binary semaphore, an event flag or similar.
+    // feedRx may be called from an ISR or another thread, but there must only be one producer.
+    // Stop calling feedRx (detach the ISR, stop the thread) before calling disableRxFeed.
+    bool enableRxFeed(void (*waitFn)(unsigned long maxMillis), void (*notifyFn)(void),
+                      size_t size = UBX_CELL_RX_FEED_SIZE);
+    void disableRxFeed(void);
+    size_t feedRx(const char *data, size_t len); // Returns the number of bytes accepted. The rest are dropped
+    uint32_t rxFeedOverruns(void)                // The number of bytes dropped because the feed was full
+    {
+        return _rxFeedOverruns;
+    }
+
     // Callbacks (called during polling)
     void setSocketListenCallback(void (*socketListenCallback)(
         int, IPAddress, unsigned int, int, IPAddress,
@@ -810,8 +939,31 @@ class SparkFun_ublox_Cellular : public Print
 
     // V24 Control and V25ter (UART interface) AT commands
     UBX_CELL_error_t setBaud(unsigned long baud);
+    // Find the module's current baud rate quickly: the last known rate and the default are tried first
+    UBX_CELL_error_t detectBaud(void);
+    // Find the current baud rate, then step up through UBX_CELL_SUPPORTED_BAUD (up to maxBaud), qualifying each rate
+    // with a burst of +IPR? round trips. A step is kept only if every probe returns the right rate and throughput does
+    // not fall. Otherwise the module is put back on the last good rate. The result is remembered and reported below
+    UBX_CELL_error_t negotiateBaud(unsigned long maxBaud = 921600);
+    unsigned long getBaud(void) // The baud rate the driver is using
+    {
+        return _baud;
+    }
+    unsigned long getLinkThroughput(void) // Bytes per second measured at that rate by negotiateBaud. 0 if not measured
+    {
+        return _linkThroughput;
+    }
     UBX_CELL_error_t setFlowControl(UBX_CELL_flow_control_t value = UBX_CELL_ENABLE_FLOW_CONTROL);
 
+    // Multiplexing (3GPP TS 27.010 CMUX)
+    // Put the module into multiplexer mode on this driver's link, open the mux's channels, then move this driver onto
+    // one of them. mux must be built on the same link. Begin other instances on the other channels to pin work to
+    // them - e.g. bulk socket and file reads on UBX_CELL_CMUX_DATA_CHANNEL - so a long response on one channel does
+    // not hold up the others. URCs are sent on the channel which enabled them or opened the socket
+    UBX_CELL_error_t startMux(SparkFun_ublox_Cellular_CMUX &mux, int channel = UBX_CELL_CMUX_CONTROL_CHANNEL);
+    // Close the multiplexer and move this driver back onto the link it used before startMux
+    UBX_CELL_error_t stopMux(void);
+
     // GPIO
     // GPIO pin map
     typedef enum
@@ -873,7 +1025,7 @@ class SparkFun_ublox_Cellular : public Print
     UBX_CELL_error_t socketConnect(int socket, IPAddress address, unsigned int port);
     // Write data to the specified socket. Works with binary data - but you must specify the data length when using the
     // const char * version Works with both TCP and UDP sockets - but socketWriteUDP is preferred for UDP and doesn't
-    // require socketOpen to be called first
+    // require socketOpen to be called first. Data longer than 1024 bytes is sent with several +USOWR commands
     UBX_CELL_error_t socketWrite(int socket, const char *str, int len = -1);
     UBX_CELL_error_t socketWrite(int socket, String str); // OK for binary data
     // Write UDP data to the specified IP Address and port.
@@ -882,6 +1034,22 @@ class SparkFun_ublox_Cellular : public Print
     UBX_CELL_error_t socketWriteUDP(int socket, const char *address, int port, const char *str, int len = -1);
     UBX_CELL_error_t socketWriteUDP(int socket, IPAddress address, int port, const char *str, int len = -1);
     UBX_CELL_error_t socketWriteUDP(int socket, String address, int port, String str);
+    // Milliseconds to wait after the @ prompt of socketWrite (and the > of appendFileContents) before sending the data.
+    // Default UBX_CELL_PROMPT_DELAY, as the u-blox specification says. Firmware which takes the data straight away
+    // can use 0. Hex mode (setSocketHexMode) has no prompt at all
+    void setPromptDelay(unsigned long promptDelay);
+
+    // Socket write buffers
+    // Many small socketWrites each cost a full +USOWR transaction. With a write buffer, a TCP socket collects them and
+    // sends them together: when the buffer is full, when the oldest byte has waited flushDelay millis (checked by
+    // socketWrite, bufferedPoll and poll), on socketFlush, and before socketClose and socketDirectLinkMode.
+    // Writes which would not fit in the buffer on their own are sent straight away, after anything already buffered.
+    // Errors from a write which is only buffered show up when the data is sent: from socketWrite or socketFlush,
+    // or as a debug message when bufferedPoll or poll sends it. Closing the socket frees the buffer
+    bool setSocketWriteBuffer(int socket, size_t size = UBX_CELL_SOCKET_WRITE_BUFFER_SIZE,
+                              unsigned long flushDelay = UBX_CELL_SOCKET_WRITE_DELAY); // size 0 flushes and frees it
+    UBX_CELL_error_t socketFlush(int socket); // Send any buffered data now
+    size_t socketBuffered(int socket);        // The number of bytes waiting in the socket's write buffer
     // Read data from the specified socket
     // Call socketReadAvailable first to determine how much data is available - or use the callbacks (triggered by
     // URC's) Works for both TCP and UDP - but socketReadUDP is preferred for UDP as it records the remote IP Address
@@ -902,13 +1070,21 @@ class SparkFun_ublox_Cellular : public Print
     // Start listening for a connection on the specified port. The connection is reported via the socket listen callback
     UBX_CELL_error_t socketListen(int socket, unsigned int port);
     // Place the socket into direct link mode - making it easy to transfer binary data. Wait two seconds and then send
-    // +++ to exit the link.
+    // +++ to exit the link. SparkFun_ublox_Cellular_DirectLink does all of this and wraps the link in a Stream.
     UBX_CELL_error_t socketDirectLinkMode(int socket);
     // Configure when direct link data is sent
     UBX_CELL_error_t socketDirectLinkTimeTrigger(int socket, unsigned long timerTrigger);
     UBX_CELL_error_t socketDirectLinkDataLengthTrigger(int socket, int dataLengthTrigger);
     UBX_CELL_error_t socketDirectLinkCharacterTrigger(int socket, int characterTrigger);
     UBX_CELL_error_t socketDirectLinkCongestionTimer(int socket, unsigned long congestionTimer);
+    // Hex mode (+UDCONF=1): socketRead, socketWrite and their UDP versions move data as two hex digits per byte.
+    // Binary safe, with no data prompt to wait for, but each read or write carries at most 512 bytes.
+    // A UDP write which is longer than that fails with UBX_CELL_ERROR_UNEXPECTED_PARAM
+    UBX_CELL_error_t setSocketHexMode(bool enable);
+    bool socketHexMode(void)
+    {
+        return _socketHexMode;
+    }
     // Use +USOCTL (Socket control) to query the socket parameters
     UBX_CELL_error_t querySocketType(int socket, UBX_CELL_socket_protocol_t *protocol);
     UBX_CELL_error_t querySocketLastError(int socket, int *error);
@@ -1066,16 +1242,50 @@ class SparkFun_ublox_Cellular : public Print
                                              unsigned long commandTimeout, int destSize = minimumResponseAllocation,
                                              bool at = true);
 
+    // Asynchronous commands. The command is sent straight away and the call returns a handle. bufferedPoll (or poll)
+    // then collects the response along with any URCs, and calls callback (if any) when the command completes.
+    // Only one command can be in progress: sendCommandAsync returns UBX_CELL_COMMAND_HANDLE_INVALID while another is.
+    // Any blocking function called meanwhile (including from a URC handler) waits for it to complete first. Then the
+    // callback is held back until the next bufferedPoll, poll or waitForCommand, so a callback which sends the next
+    // command never interrupts another.
+    // expectedResponse and responseDest must stay valid until the command completes (and its callback, if any, has
+    // been called). The response is NUL-terminated if it fits in destSize
+    UBX_CELL_command_handle_t sendCommandAsync(const char *command, const char *expectedResponse,
+                                               UBX_CELL_command_callback_t callback = nullptr,
+                                               char *responseDest = nullptr, int destSize = minimumResponseAllocation,
+                                               unsigned long commandTimeout = UBX_CELL_STANDARD_RESPONSE_TIMEOUT,
+                                               bool at = true);
+    // Close a socket without waiting up to two minutes for the module to say OK
+    UBX_CELL_command_handle_t socketCloseAsync(int socket, UBX_CELL_command_callback_t callback = nullptr,
+                                               unsigned long timeout = UBX_CELL_2_MIN_TIMEOUT);
+    // Scan for operators (+COPS=?, which takes up to three minutes) without blocking. op must stay valid until the
+    // command completes: the operators found are stored there before callback is called
+    UBX_CELL_command_handle_t getOperatorsAsync(struct operator_stats *op, int maxOps = 3,
+                                                UBX_CELL_operators_callback_t callback = nullptr);
+    bool commandInProgress(void)
+    {
+        return _asyncHandle != UBX_CELL_COMMAND_HANDLE_INVALID;
+    }
+    // UBX_CELL_ERROR_IN_PROGRESS until the command completes, then its result. Only the result of the most recent
+    // asynchronous command is kept: older handles give UBX_CELL_ERROR_INVALID
+    UBX_CELL_error_t commandResult(UBX_CELL_command_handle_t handle);
+    // Block until the command completes. Returns its result
+    UBX_CELL_error_t waitForCommand(UBX_CELL_command_handle_t handle);
+
     char *ubx_cell_calloc_char(size_t num);
 
     // Add a URC handler
     void addURCHandler(const char *urcString, UBX_CELL_urc_handler_t urcHandler);
 
   protected:
+    friend class SparkFun_ublox_Cellular_DirectLink; // Reads and writes the raw link while a socket is in Direct Link mode
+    friend class SparkFun_ublox_Cellular_Client;     // Registers itself in _socketClients
+
     HardwareSerial *_hardSerial;
 #ifdef UBX_CELL_SOFTWARE_SERIAL_ENABLED
     SoftwareSerial *_softSerial;
 #endif
+    SparkFun_ublox_Cellular_Transport *_transport;
 
     Print *_debugPort;          // The stream to send debug messages to if enabled. Usually Serial.
     bool _printDebug = false;   // Flag to print debugging variables
@@ -1087,6 +1297,15 @@ class SparkFun_ublox_Cellular : public Print
     bool _invertPowerPin = false;
 
     unsigned long _baud;
+    unsigned long _linkThroughput; // Bytes per second, measured by negotiateBaud
+
+    // Multiplexer, and the link this driver used before startMux
+    SparkFun_ublox_Cellular_CMUX *_mux;
+    HardwareSerial *_muxHardSerial;
+#ifdef UBX_CELL_SOFTWARE_SERIAL_ENABLED
+    SoftwareSerial *_muxSoftSerial;
+#endif
+    SparkFun_ublox_Cellular_Transport *_muxTransport;
     IPAddress _lastRemoteIP;
     IPAddress _lastLocalIP;
     uint8_t _maxInitTries;
@@ -1096,13 +1315,135 @@ class SparkFun_ublox_Cellular : public Print
     bool _pollReentrant = false; // Prevent reentry of poll - just in case it gets called from a callback
 
 #define _RXBuffSize 2056
+#define _RXEventSlack 256 // Extra space after the end of the ring. An event which wraps is made contiguous in here
+#define _RXMaxEvents 64   // The maximum number of complete events the ring can index. rxRingFill never overfills it.
+                          // While a command is active, rxRingMergeEvents makes room by merging URC lines instead
     const unsigned long _rxWindowMillis = 2; // 1ms is not quite long enough for a single char at 9600 baud. millis roll
                                              // over much less often than micros. See notes in .cpp re. ESP32!
-    char *_saraRXBuffer;                     // Allocated in UBX_CELL::begin
-    char *_pruneBuffer;
-    char *_saraResponseBacklog;
-    int _saraResponseBacklogLength =
-        0; // The backlog could contain binary data so we can't use strlen to find its length
+
+    typedef enum
+    {
+        UBX_CELL_RX_EVENT_LINE = 0, // A line of text, e.g. a URC. The only kind handed to the URC handlers
+        UBX_CELL_RX_EVENT_PROMPT,   // A > or @ data prompt. No delimiter follows it
+        UBX_CELL_RX_EVENT_PAYLOAD   // A response line which carries binary data (+USORD, +URDFILE...). May hold NULs and line ends
+    } UBX_CELL_rx_event_type_t;
+
+    typedef struct
+    {
+        uint16_t start;  // Ring index of the first character of the event
+        uint16_t length; // Length of the event. The delimiter which ended it (if any) follows it in the ring
+        uint8_t type;    // UBX_CELL_rx_event_type_t
+    } UBX_CELL_rx_event_t;
+
+    // Single RX store. Everything received from the module which has not been processed yet - the backlog of URCs
+    // left behind by commands, and new serial data read by bufferedPoll - lives in this ring. Bytes are tokenized one
+    // at a time as they arrive: each complete line, data prompt or binary payload response ('event') is indexed in
+    // _rxEvents, so nothing is ever re-tokenized, copied or cleared in bulk.
+    char *_rxRing;          // Allocated in UBX_CELL::begin. _RXBuffSize + _RXEventSlack bytes
+    int _rxRingHead = 0;    // Ring index where the next byte will be written
+    int _rxRingTail = 0;    // Ring index of the oldest unprocessed byte
+    int _rxRingUsed = 0;    // Number of bytes between _rxRingTail and _rxRingHead
+    int _rxLineLength = 0;  // Length of the (incomplete) line which ends at _rxRingHead
+    UBX_CELL_rx_event_t _rxEvents[_RXMaxEvents]; // Index of the complete events in the ring, oldest first
+    int _rxEventFirst = 0;  // Index into _rxEvents of the oldest event
+    int _rxEventCount = 0;  // Number of indexed events
+    int _rxEventKept = 0;   // The oldest _rxEventKept events are known to be wanted and are skipped by pruneBacklog
+
+    // Tokenizer state. Bytes are classified once, as they are added to the ring
+    char _rxLastChar = '\n';       // The byte before the one being tokenized
+    bool _rxLinePayload = false;   // The current line carries a binary payload
+    int _rxPayloadRemaining = 0;   // Bytes of that payload still to come. Line ends inside it are data
+    long _rxField = -1;            // Value of the numeric field being scanned, or -1 if it is not a number after a comma
+    long _rxLastField = -1;        // Value of the numeric field before the last comma, or -1
+    UBX_CELL_result_code_t _rxResultCode = UBX_CELL_RESULT_NONE; // The last final result code line seen
+    int _rxResultCause = -1;                                      // Its +CME / +CMS ERROR cause
+    bool _rxDialing = false;       // The last command sent was ATD: the dial result codes (NO CARRIER...) end it
+    bool _rxCommandActive = false; // A command is waiting for its response: only URCs are kept in the ring
+
+    UBX_CELL_result_t _lastResult; // The outcome of the last command, for getLastResult
+
+#define _RXStageSize 256
+    // Block-read staging buffer. The serial port is drained in bulk into here and the response matchers consume it
+    // byte by byte without going back to the port. Any bytes left over after a match stay here for the next reader.
+    char _rxStage[_RXStageSize];
+    int _rxStageHead = 0; // Index of the next unread byte
+    int _rxStageTail = 0; // Index one past the last staged byte
+
+    // Matches the expected response and error of the command in progress. Set up by each transaction
+    SparkFun_ublox_Cellular_Matcher _responseMatcher;
+
+    // Response and temporary buffers. Released back to their mark before each function returns
+    SparkFun_ublox_Cellular_Arena _arena;
+    size_t _arenaSize = UBX_CELL_ARENA_SIZE; // The size begin allocates
+    char *responseAlloc(size_t size); // From the arena, or the heap if it does not fit. nullptr if neither has room
+    void responseRelease(char *response, size_t arenaMark); // Free response, and release the arena to arenaMark
+
+    // The command being built (see SparkFun_ublox_Cellular_Command). Free again as soon as the command has been sent
+    char _txCommand[UBX_CELL_COMMAND_BUFFER_SIZE];
+
+    // The command waiting for its response. commandBegin sets it up, commandStep collects the response and commandEnd
+    // finishes it. sendCommandWithResponse runs all three in turn. For an asynchronous command, bufferedPoll and poll
+    // call commandStep via commandService
+    typedef struct
+    {
+        const char *expectedResponse;
+        char *responseDest;
+        int destSize;
+        int destIndex;
+        int errorMatch; // The matcher's index for the expected error
+        bool found;
+        bool error;
+        bool printedSomething;
+        unsigned int charsRead;
+        unsigned long timeIn;
+        unsigned long timeout;
+        unsigned long foundAt; // millis() when the response was matched, e.g. the arrival of a "@" prompt
+        char *payloadDest;  // If not nullptr, binary payload goes straight here, not into responseDest or the ring
+        int payloadSize;
+        int payloadLength;  // Bytes stored in payloadDest
+        bool payloadHex;    // The payload is hex digits, to be decoded
+        bool payloadHalf;   // payloadDigit is the first digit of a pair
+        char payloadDigit;
+        bool payloadError;  // The payload held something which is not a hex digit
+    } UBX_CELL_command_state_t;
+    UBX_CELL_command_state_t _command;
+    UBX_CELL_command_handle_t _asyncHandle = UBX_CELL_COMMAND_HANDLE_INVALID;     // The command in progress, if any
+    UBX_CELL_command_handle_t _asyncLastHandle = UBX_CELL_COMMAND_HANDLE_INVALID; // The most recently issued handle
+    UBX_CELL_error_t _asyncResult = UBX_CELL_ERROR_INVALID;                       // The result of _asyncLastHandle
+    UBX_CELL_command_callback_t _asyncCallback = nullptr;
+    // A command which completed while a blocking command waited for it. Its callback has not been called yet
+    UBX_CELL_command_callback_t _asyncDoneCallback = nullptr;
+    UBX_CELL_command_handle_t _asyncDoneHandle = UBX_CELL_COMMAND_HANDLE_INVALID;
+    UBX_CELL_error_t _asyncDoneResult = UBX_CELL_ERROR_INVALID;
+    const char *_asyncDoneResponse = nullptr;
+    // getOperatorsAsync: where the operators go, and its response buffer (on the heap) until the command completes
+    struct operator_stats *_asyncOperators = nullptr;
+    int _asyncMaxOperators = 0;
+    char *_asyncOperatorsResponse = nullptr;
+    UBX_CELL_operators_callback_t _asyncOperatorsCallback = nullptr;
+    UBX_CELL_operators_callback_t _asyncDoneOperatorsCallback = nullptr;
+    uint8_t _asyncDoneOperators = 0;
+
+    // TX queue. Bytes are added at _txQueueHead and sent from _txQueueTail
+    char *_txQueue;                 // Allocated by enableTxQueue. nullptr while the queue is disabled
+    int _txQueueSize = 0;
+    int _txQueueHead = 0;
+    int _txQueueTail = 0;
+    int _txQueueUsed = 0;
+    uint32_t _txWouldBlock = 0;
+    uint32_t _txPartialWrites = 0;
+
+    // Interrupt / callback driven RX. feedRx (the producer) owns _rxFeedHead. The driver (the consumer) owns
+    // _rxFeedTail. Each reads the other's index with an acquire load, so the pair works across an ISR or a thread
+    char *_rxFeed;                          // Allocated by enableRxFeed. nullptr while the feed is disabled
+    uint16_t _rxFeedSize;                   // One slot is always left empty, so the feed holds _rxFeedSize - 1 bytes
+    uint16_t _rxFeedHead;                   // Index where feedRx will write the next byte
+    uint16_t _rxFeedTail;                   // Index of the next byte the driver will read
+    volatile uint32_t _rxFeedOverruns;      // Bytes dropped by feedRx
+    volatile char _rxWakeResponse;          // feedRx notifies the waiter when this arrives
+    volatile char _rxWakeError;             // or this
+    void (*_rxWaitCallback)(unsigned long); // Sleep until notified, or for the given number of millis
+    void (*_rxNotifyCallback)(void);        // Wake the waiter
 
     void (*_socketListenCallback)(int, IPAddress, unsigned int, int, IPAddress, unsigned int);
     void (*_socketReadCallback)(int, String);
@@ -1123,8 +1464,32 @@ class SparkFun_ublox_Cellular : public Print
     std::vector<const char *> _urcStrings;
     std::vector<UBX_CELL_urc_handler_t> _urcHandlers;
 
+    // URC dispatch index: a prefix trie of _urcStrings, built by addURCHandler. Node 0 is the root.
+    // An event is walked through it once, so only the handlers whose URC it contains are called
+    typedef struct
+    {
+        char c;          // The character this node matches
+        int16_t child;   // First node for the next character, or -1
+        int16_t sibling; // Next alternative for the same character position, or -1
+        int16_t handler; // Index into _urcHandlers of the first handler for the URC which ends here, or -1
+    } UBX_CELL_urc_index_node_t;
+    std::vector<UBX_CELL_urc_index_node_t> _urcIndex;
+    std::vector<int16_t> _urcNextHandler; // For each handler, the next handler for the same URC string, or -1
+
     int _lastSocketProtocol[UBX_CELL_NUM_SOCKETS]; // Record the protocol for each socket to avoid having to call
                                                    // querySocketType in parseSocketReadIndication
+    // The client which owns each socket, if any. Its +UUSORD and +UUSOCL go to the client, not the callbacks
+    SparkFun_ublox_Cellular_Client *_socketClients[UBX_CELL_NUM_SOCKETS];
+
+    typedef struct
+    {
+        char *data; // Allocated by setSocketWriteBuffer. nullptr while the socket writes straight through
+        int size;
+        int used;
+        unsigned long firstAt;    // millis() when the oldest buffered byte was written
+        unsigned long flushDelay; // Send the data once it is this old
+    } UBX_CELL_socket_write_buffer_t;
+    UBX_CELL_socket_write_buffer_t _socketWriteBuffers[UBX_CELL_NUM_SOCKETS];
 
     typedef enum
     {
@@ -1149,7 +1514,34 @@ class SparkFun_ublox_Cellular : public Print
     // Send a command -- prepend AT if at is true
     void sendCommand(const char *command, bool at);
 
+    void commandBegin(const char *command, const char *expectedResponse, char *responseDest, int destSize,
+                      unsigned long commandTimeout, bool at); // Send the command and get ready for its response
+    bool commandStep(void);          // Process what has arrived. Returns true once the command has matched or timed out
+    unsigned long commandTimeLeft(void); // Millis until the command times out, or 0
+    UBX_CELL_error_t commandEnd(void); // Finish the command. Returns its result
+    // Advance the asynchronous command. Returns true if none is in progress. If it completes, its callback is called
+    // now, or held for commandCallback if callNow is false
+    bool commandService(bool callNow = true);
+    void commandCallback(void); // Call the callback held back by commandService, if any
+    void commandFinish(void);   // Wait for any asynchronous command to complete, holding back its callback
+    void commandPayload(const char *src, int len); // Store payload bytes (or digits) in payloadDest
+    // Send a command whose response carries binary data (+USORD, +USORF). The response, less its payload, goes in
+    // responseDest. The payload streams straight into payloadDest. *payloadLength is set to the number of bytes stored
+    UBX_CELL_error_t sendCommandWithPayload(const char *command, char *responseDest, int destSize, char *payloadDest,
+                                            int payloadSize, bool hex, int *payloadLength);
+
     const int _saraR5maxSocketRead = 1024; // The limit on bytes that can be read in a single read
+    const int _saraR5maxSocketHexData = 512; // The limit on bytes in a single hex mode read or write
+    const int _saraR5maxSocketWrite = 1024;  // The limit on bytes in a single binary mode write
+    unsigned long _promptDelay = UBX_CELL_PROMPT_DELAY;
+    void waitAfterPrompt(void); // Wait _promptDelay millis after a data prompt
+    bool _socketHexMode = false;             // +UDCONF=1,1
+
+    // Write socket data as hex, in as many commands as it takes. address is nullptr for +USOWR
+    UBX_CELL_error_t socketWriteHex(int socket, const char *address, int port, const char *str, int len);
+    UBX_CELL_error_t socketWriteData(int socket, const char *str, int len); // Write straight through, with +USOWR
+    void freeSocketWriteBuffer(int socket);
+    void socketWriteService(void); // Send any buffered data which has waited its flushDelay
 
     UBX_CELL_error_t parseSocketReadIndication(int socket, int length);
     UBX_CELL_error_t parseSocketReadIndicationUDP(int socket, int length);
@@ -1157,14 +1549,44 @@ class SparkFun_ublox_Cellular : public Print
                                                  int socket, IPAddress remoteIP, unsigned int port);
     UBX_CELL_error_t parseSocketCloseIndication(String *closeIndication);
 
+    uint8_t parseOperators(const char *response, struct operator_stats *opRet, int maxOps); // From +COPS=?
+
     // UART Functions
     size_t hwPrint(const char *s);
     size_t hwWriteData(const char *buff, int len);
     size_t hwWrite(const char c);
+    size_t hwWritev(const UBX_CELL_iovec_t *iov, int count); // Write count segments in one go where the link allows
+    size_t hwTryWrite(const char *buff, size_t len);         // Write what the link will accept without waiting
+    size_t txQueueData(const char *buff, size_t len);        // Queue len bytes, draining as needed. Returns bytes queued
+    size_t txDrain(void);                                    // Send what the link will accept. Returns bytes sent
     int readAvailable(char *inString);
     char readChar(void);
     int hwAvailable(void);
+    size_t hwReadBytes(char *dest, size_t len); // Read up to len bytes which are already available, in one call
+    int rxFill(void);                           // Top up _rxStage from the serial port. Returns the staged byte count
+    int rxRead(char *dest, int len);            // Copy up to len bytes (staged first, then the port) into dest
+    void rxRingReset(void);                     // Empty the ring and its event index
+    bool rxRingMakeRoom(void);                  // Discard a stale partial line if it has filled the ring
+    int rxRingFill(void);                       // Drain the serial port straight into the ring. Returns the byte count
+    bool rxRingPut(char c);                     // Append one byte to the ring
+    void rxRingCommit(int len);                 // Tokenize the len bytes which have just been written at _rxRingHead
+    void rxRingAddEvent(int start, int length, UBX_CELL_rx_event_type_t type); // Add an event to the index
+    bool rxRingMergeEvents(void);               // Free index entries by merging neighbouring URC lines
+    void rxRingDrop(int len);                   // Discard the newest len bytes
+    int rxRingPayloadWidth(void); // Characters per byte if the current line is a response which carries binary data
+    void rxRingCheckResult(int start, int length); // Note the line if it is a final result code
+    UBX_CELL_error_t setLastResult(UBX_CELL_error_t err); // Record the outcome of a command for getLastResult. Returns err
+    char *rxRingFront(void);                    // The oldest event, as a C string. Valid until rxRingPop
+    void rxRingPop(void);                       // Discard the oldest event
+    void rxRingMove(int dest, int src, int len); // Move len bytes within the ring, towards the tail
+    size_t rxFeedRead(char *dest, size_t len);   // Read up to len bytes from the RX feed
+    int rxFeedAvailable(void);                   // The number of bytes waiting in the RX feed
+    void rxWaitFor(const char *expectedResponse, const char *expectedError); // Set the bytes which wake rxWait
+    void rxWait(unsigned long maxMillis); // Sleep until more data may have arrived (RX feed), or just yield
     virtual void beginSerial(unsigned long baud);
+    void hwBegin(unsigned long baud);    // (Re)start the serial port or transport at baud. No delays
+    void switchBaud(unsigned long baud); // hwBegin, let the line settle and discard anything received at the old rate
+    UBX_CELL_error_t probeBaud(unsigned long baud, unsigned long *throughput); // Qualify the link at baud
     void setTimeout(unsigned long timeout);
     bool find(char *target);
 
@@ -1184,6 +1606,10 @@ class SparkFun_ublox_Cellular : public Print
     bool urcHandlerEPSRegistrationStatus(const char *event);
 
     bool processURCEvent(const char *event);
+    bool processURCLines(char *event); // Process each line of an event. Events merged by rxRingMergeEvents hold several
+    // Walk length bytes from buf[start] (wrapping at bufSize) through the URC index. If event is not nullptr, call the
+    // handlers of each URC found until one returns true. Otherwise just report whether any URC was found
+    bool urcIndexSearch(const char *buf, int bufSize, int start, int length, const char *event);
     void pruneBacklog(void);
 
     // GPS Helper functions
@@ -0,0 +1,65 @@
+#include "sfe_ublox_cellular_arena.h"
+
+SparkFun_ublox_Cellular_Arena::SparkFun_ublox_Cellular_Arena()
+{
+    _buf = nullptr;
+    _size = 0;
+    _used = 0;
+    _highWater = 0;
+    _failures = 0;
+}
+
+SparkFun_ublox_Cellular_Arena::~SparkFun_ublox_Cellular_Arena()
+{
+    end();
+}
+
+bool SparkFun_ublox_Cellular_Arena::begin(size_t size)
+{
+    if ((_buf != nullptr) && (_size == size))
+        return true;
+    if (_used > 0)
+        return false;
+
+    end();
+    _buf = new char[size];
+    if (_buf == nullptr)
+        return false;
+    _size = size;
+    return true;
+}
+
+void SparkFun_ublox_Cellular_Arena::end(void)
+{
+    if (_buf != nullptr)
+    {
+        delete[] _buf;
+        _buf = nullptr;
+    }
+    _size = 0;
+    _used = 0;
+}
+
+char *SparkFun_ublox_Cellular_Arena::alloc(size_t size)
+{
+    // Keep every allocation pointer-aligned, so the arena can hold more than chars
+    size_t aligned = (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    if ((aligned < size) || (aligned > _size - _used))
+    {
+        _failures++;
+        return nullptr;
+    }
+
+    char *block = &_buf[_used];
+    memset(block, 0, size);
+    _used += aligned;
+    if (_used > _highWater)
+        _highWater = _used;
+    return block;
+}
+
+void SparkFun_ublox_Cellular_Arena::release(size_t mark)
+{
+    if (mark < _used)
+        _used = mark;
+}
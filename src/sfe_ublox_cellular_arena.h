@@ -0,0 +1,67 @@
+#ifndef SFE_UBLOX_CELLULAR_ARENA_H
+#define SFE_UBLOX_CELLULAR_ARENA_H
+
+#if (ARDUINO >= 100)
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+// A fixed block of memory which response and temporary buffers are carved from, instead of the heap. It is allocated
+// once and never freed while the driver runs, so long-running units cannot fragment the heap with them.
+// Allocations are stacked: a function takes a mark, allocates what it needs and releases back to its mark on every
+// return path. Anything it calls (or any URC handler which runs meanwhile) does the same above it, so the arena is
+// empty again at the end of each transaction.
+class SparkFun_ublox_Cellular_Arena
+{
+  public:
+    SparkFun_ublox_Cellular_Arena();
+    ~SparkFun_ublox_Cellular_Arena();
+
+    // Allocate (or re-size) the block. Fails if it is in use
+    bool begin(size_t size);
+    void end(void);
+
+    // size bytes, zeroed, or nullptr if there is not enough room left
+    char *alloc(size_t size);
+    size_t mark(void) // Pass to release to free everything allocated after this
+    {
+        return _used;
+    }
+    void release(size_t mark);
+    bool contains(const char *block) // True if block was allocated from the arena
+    {
+        return (_buf != nullptr) && (block >= _buf) && (block < &_buf[_size]);
+    }
+
+    size_t size(void)
+    {
+        return _size;
+    }
+    size_t used(void)
+    {
+        return _used;
+    }
+    size_t highWater(void) // The most that has been in use at once
+    {
+        return _highWater;
+    }
+    uint32_t failures(void) // The number of allocations which did not fit
+    {
+        return _failures;
+    }
+    void resetHighWater(void)
+    {
+        _highWater = _used;
+        _failures = 0;
+    }
+
+  protected:
+    char *_buf;
+    size_t _size;
+    size_t _used;
+    size_t _highWater;
+    uint32_t _failures;
+};
+
+#endif // SFE_UBLOX_CELLULAR_ARENA_H
@@ -0,0 +1,212 @@
+#include "sfe_ublox_cellular_client.h"
+
+SparkFun_ublox_Cellular_Client::SparkFun_ublox_Cellular_Client(SparkFun_ublox_Cellular &cell)
+{
+    _cell = &cell;
+    _socket = -1;
+    _remoteClosed = false;
+    _pending = 0;
+    _rxHead = 0;
+    _rxTail = 0;
+    _rxUsed = 0;
+}
+
+SparkFun_ublox_Cellular_Client::~SparkFun_ublox_Cellular_Client()
+{
+    stop();
+}
+
+int SparkFun_ublox_Cellular_Client::connect(IPAddress ip, uint16_t port)
+{
+    stop();
+
+    int socket = _cell->socketOpen(UBX_CELL_TCP);
+    if (socket < 0)
+        return 0;
+
+    if (_cell->socketConnect(socket, ip, port) != UBX_CELL_ERROR_SUCCESS)
+    {
+        _cell->socketClose(socket);
+        return 0;
+    }
+
+    return begin(socket);
+}
+
+int SparkFun_ublox_Cellular_Client::connect(const char *host, uint16_t port)
+{
+    stop();
+
+    int socket = _cell->socketOpen(UBX_CELL_TCP);
+    if (socket < 0)
+        return 0;
+
+    if (_cell->socketConnect(socket, host, port) != UBX_CELL_ERROR_SUCCESS)
+    {
+        _cell->socketClose(socket);
+        return 0;
+    }
+
+    return begin(socket);
+}
+
+int SparkFun_ublox_Cellular_Client::begin(int socket)
+{
+    _socket = socket;
+    _remoteClosed = false;
+    _pending = 0;
+    _rxHead = 0;
+    _rxTail = 0;
+    _rxUsed = 0;
+    _cell->_socketClients[socket] = this;
+    return 1;
+}
+
+void SparkFun_ublox_Cellular_Client::release(void)
+{
+    if ((_socket >= 0) && (_cell->_socketClients[_socket] == this))
+        _cell->_socketClients[_socket] = nullptr;
+    _socket = -1;
+    _pending = 0;
+}
+
+size_t SparkFun_ublox_Cellular_Client::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t SparkFun_ublox_Cellular_Client::write(const uint8_t *buf, size_t size)
+{
+    if ((_socket < 0) || _remoteClosed || (size == 0))
+        return 0;
+    if (_cell->socketWrite(_socket, (const char *)buf, (int)size) != UBX_CELL_ERROR_SUCCESS)
+        return 0;
+    return size;
+}
+
+int SparkFun_ublox_Cellular_Client::available(void)
+{
+    return fill();
+}
+
+int SparkFun_ublox_Cellular_Client::read(void)
+{
+    if (fill() == 0)
+        return -1;
+    char c = _rx[_rxHead];
+    _rxHead = (_rxHead + 1) % UBX_CELL_CLIENT_BUFFER_SIZE;
+    _rxUsed--;
+    return (uint8_t)c;
+}
+
+int SparkFun_ublox_Cellular_Client::read(uint8_t *buf, size_t size)
+{
+    size_t numRead = 0;
+    while (numRead < size)
+    {
+        int avail = fill();
+        if (avail == 0)
+            break;
+        int contiguous = UBX_CELL_CLIENT_BUFFER_SIZE - _rxHead;
+        if (avail > contiguous)
+            avail = contiguous;
+        if ((size_t)avail > size - numRead)
+            avail = size - numRead;
+        memcpy(&buf[numRead], &_rx[_rxHead], avail);
+        _rxHead = (_rxHead + avail) % UBX_CELL_CLIENT_BUFFER_SIZE;
+        _rxUsed -= avail;
+        numRead += avail;
+    }
+    return (int)numRead;
+}
+
+int SparkFun_ublox_Cellular_Client::peek(void)
+{
+    if (fill() == 0)
+        return -1;
+    return (uint8_t)_rx[_rxHead];
+}
+
+void SparkFun_ublox_Cellular_Client::flush(void)
+{
+    if (_socket >= 0)
+        _cell->socketFlush(_socket);
+    _cell->txFlush(UBX_CELL_SOCKET_WRITE_TIMEOUT);
+}
+
+void SparkFun_ublox_Cellular_Client::stop(void)
+{
+    if (_socket < 0)
+        return;
+
+    int socket = _socket;
+    bool remoteClosed = _remoteClosed;
+    release();
+    _rxHead = 0;
+    _rxTail = 0;
+    _rxUsed = 0;
+
+    if (!remoteClosed) // After +UUSOCL the module has already closed it
+        _cell->socketClose(socket);
+}
+
+uint8_t SparkFun_ublox_Cellular_Client::connected(void)
+{
+    if (_socket < 0)
+        return 0;
+    if (_rxUsed == 0)
+        fill(); // Look for +UUSOCL
+    return ((!_remoteClosed) || (_rxUsed > 0)) ? 1 : 0;
+}
+
+SparkFun_ublox_Cellular_Client::operator bool(void)
+{
+    return _socket >= 0;
+}
+
+// Read as much pending data as there is room for, straight into the free space of _rx: up to the physical end of the
+// buffer, then on from the start. If there is nothing to read, let bufferedPoll look for +UUSORD (and +UUSOCL)
+int SparkFun_ublox_Cellular_Client::fill(void)
+{
+    if (_socket < 0)
+        return _rxUsed;
+
+    if ((_rxUsed == 0) && (_pending == 0))
+        _cell->bufferedPoll(); // Calls dataAvailable, which fills _rx, if there is new data
+
+    for (int pass = 0; (pass < 2) && (_pending > 0) && (_socket >= 0); pass++)
+    {
+        int space = UBX_CELL_CLIENT_BUFFER_SIZE - _rxTail; // Contiguous space
+        if (space > UBX_CELL_CLIENT_BUFFER_SIZE - _rxUsed)
+            space = UBX_CELL_CLIENT_BUFFER_SIZE - _rxUsed;
+        if (space > _pending)
+            space = _pending;
+        if (space == 0)
+            break;
+
+        int bytesRead = 0;
+        UBX_CELL_error_t err = _cell->socketRead(_socket, space, &_rx[_rxTail], &bytesRead);
+        _rxTail = (_rxTail + bytesRead) % UBX_CELL_CLIENT_BUFFER_SIZE;
+        _rxUsed += bytesRead;
+        _pending -= bytesRead;
+        if (err != UBX_CELL_ERROR_SUCCESS)
+        {
+            _pending = 0; // Ask the module again when the next +UUSORD arrives
+            break;
+        }
+    }
+
+    return _rxUsed;
+}
+
+void SparkFun_ublox_Cellular_Client::dataAvailable(int length)
+{
+    _pending = length; // +UUSORD gives the total the module holds, not what is new
+    fill();
+}
+
+void SparkFun_ublox_Cellular_Client::remoteClose(void)
+{
+    _remoteClosed = true;
+    _pending = 0;
+}
@@ -0,0 +1,64 @@
+#ifndef SFE_UBLOX_CELLULAR_CLIENT_H
+#define SFE_UBLOX_CELLULAR_CLIENT_H
+
+#include "sfe_ublox_cellular.h"
+
+#include <Client.h>
+
+#define UBX_CELL_CLIENT_BUFFER_SIZE 1024 // Bytes of received data each client holds. Extra data waits in the module
+
+// A TCP socket as an Arduino Client, for libraries such as PubSubClient and ArduinoHttpClient.
+// Received data is buffered in the client. When +UUSORD announces new data, bufferedPoll reads as much of it as the
+// buffer has room for, in one +USORD per contiguous block. The rest stays in the module until read makes room.
+// available and read call bufferedPoll while the buffer is empty, so URCs keep being processed while a library waits
+// for data. Writes go out with socketWrite, so setSocketWriteBuffer(client.socket()) coalesces them. Nothing is lost if
+// the application is slow: the module holds the data until the client has room for it.
+class SparkFun_ublox_Cellular_Client : public Client
+{
+  public:
+    SparkFun_ublox_Cellular_Client(SparkFun_ublox_Cellular &cell);
+    ~SparkFun_ublox_Cellular_Client();
+
+    // Open a TCP socket and connect it. Returns 1 on success, 0 on failure
+    int connect(IPAddress ip, uint16_t port);
+    int connect(const char *host, uint16_t port);
+    int socket(void) // The socket in use, or -1
+    {
+        return _socket;
+    }
+
+    // Client
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buf, size_t size);
+    int available(void);
+    int read(void);
+    int read(uint8_t *buf, size_t size); // Read up to size bytes which are already available. Returns the number read
+    int peek(void);
+    void flush(void); // Send the socket's write buffer (if any). Wait for the driver's TX queue (if enabled) to empty
+    void stop(void);
+    uint8_t connected(void); // True while the socket is open, or there is still data to read
+    operator bool(void);
+    using Print::write;
+
+  protected:
+    friend class SparkFun_ublox_Cellular; // Delivers +UUSORD and +UUSOCL
+
+    SparkFun_ublox_Cellular *_cell;
+    int _socket;
+    bool _remoteClosed; // +UUSOCL: the module has closed the socket
+    int _pending;       // Bytes the module holds which have not been read yet (from +UUSORD)
+
+    // Received data waiting to be read. A ring: bytes are added at _rxTail and read from _rxHead
+    char _rx[UBX_CELL_CLIENT_BUFFER_SIZE];
+    int _rxHead;
+    int _rxTail;
+    int _rxUsed;
+
+    int begin(int socket); // Register the connected socket with the driver. Returns 1
+    void release(void);    // Unregister and forget the socket
+    int fill(void);        // Read pending data from the module into _rx. Returns the number of bytes waiting in _rx
+    void dataAvailable(int length); // +UUSORD: the module holds length bytes
+    void remoteClose(void);         // +UUSOCL
+};
+
+#endif // SFE_UBLOX_CELLULAR_CLIENT_H
@@ -0,0 +1,535 @@
+#include "sfe_ublox_cellular_cmux.h"
+
+// Frame fields (3GPP TS 27.010 basic option)
+#define UBX_CELL_CMUX_FLAG 0xF9
+#define UBX_CELL_CMUX_EA 0x01 // Extension bit: set in the last byte of an address / length field
+#define UBX_CELL_CMUX_CR 0x02 // Command / response bit
+#define UBX_CELL_CMUX_PF 0x10 // Poll / final bit
+#define UBX_CELL_CMUX_SABM 0x2F
+#define UBX_CELL_CMUX_UA 0x63
+#define UBX_CELL_CMUX_DM 0x0F
+#define UBX_CELL_CMUX_DISC 0x43
+#define UBX_CELL_CMUX_UIH 0xEF
+#define UBX_CELL_CMUX_UI 0x03
+#define UBX_CELL_CMUX_FCS_GOOD 0xCF // The FCS of a frame, including its own FCS byte, when it is intact
+
+// Control channel (DLC 0) message types, with EA set and C/R clear
+#define UBX_CELL_CMUX_MSG_NSC 0x11  // Non supported command response
+#define UBX_CELL_CMUX_MSG_TEST 0x21 // Test command
+#define UBX_CELL_CMUX_MSG_CLD 0xC1  // Multiplexer close down
+#define UBX_CELL_CMUX_MSG_MSC 0xE1  // Modem status command
+
+// V.24 signals in an MSC
+#define UBX_CELL_CMUX_MSC_FC 0x02  // Flow control: stop sending on this DLC
+#define UBX_CELL_CMUX_MSC_RTC 0x04 // Ready to communicate (DTR / DSR)
+#define UBX_CELL_CMUX_MSC_RTR 0x08 // Ready to receive (RTS / CTS)
+#define UBX_CELL_CMUX_MSC_DV 0x80  // Data valid (DCD)
+
+// CRC-8, reversed polynomial x^8 + x^2 + x + 1, as in 27.010 annex B
+static const uint8_t UBX_CELL_CMUX_CRC_TABLE[256] = {
+    0x00, 0x91, 0xE3, 0x72, 0x07, 0x96, 0xE4, 0x75, 0x0E, 0x9F, 0xED, 0x7C, 0x09, 0x98, 0xEA, 0x7B,
+    0x1C, 0x8D, 0xFF, 0x6E, 0x1B, 0x8A, 0xF8, 0x69, 0x12, 0x83, 0xF1, 0x60, 0x15, 0x84, 0xF6, 0x67,
+    0x38, 0xA9, 0xDB, 0x4A, 0x3F, 0xAE, 0xDC, 0x4D, 0x36, 0xA7, 0xD5, 0x44, 0x31, 0xA0, 0xD2, 0x43,
+    0x24, 0xB5, 0xC7, 0x56, 0x23, 0xB2, 0xC0, 0x51, 0x2A, 0xBB, 0xC9, 0x58, 0x2D, 0xBC, 0xCE, 0x5F,
+    0x70, 0xE1, 0x93, 0x02, 0x77, 0xE6, 0x94, 0x05, 0x7E, 0xEF, 0x9D, 0x0C, 0x79, 0xE8, 0x9A, 0x0B,
+    0x6C, 0xFD, 0x8F, 0x1E, 0x6B, 0xFA, 0x88, 0x19, 0x62, 0xF3, 0x81, 0x10, 0x65, 0xF4, 0x86, 0x17,
+    0x48, 0xD9, 0xAB, 0x3A, 0x4F, 0xDE, 0xAC, 0x3D, 0x46, 0xD7, 0xA5, 0x34, 0x41, 0xD0, 0xA2, 0x33,
+    0x54, 0xC5, 0xB7, 0x26, 0x53, 0xC2, 0xB0, 0x21, 0x5A, 0xCB, 0xB9, 0x28, 0x5D, 0xCC, 0xBE, 0x2F,
+    0xE0, 0x71, 0x03, 0x92, 0xE7, 0x76, 0x04, 0x95, 0xEE, 0x7F, 0x0D, 0x9C, 0xE9, 0x78, 0x0A, 0x9B,
+    0xFC, 0x6D, 0x1F, 0x8E, 0xFB, 0x6A, 0x18, 0x89, 0xF2, 0x63, 0x11, 0x80, 0xF5, 0x64, 0x16, 0x87,
+    0xD8, 0x49, 0x3B, 0xAA, 0xDF, 0x4E, 0x3C, 0xAD, 0xD6, 0x47, 0x35, 0xA4, 0xD1, 0x40, 0x32, 0xA3,
+    0xC4, 0x55, 0x27, 0xB6, 0xC3, 0x52, 0x20, 0xB1, 0xCA, 0x5B, 0x29, 0xB8, 0xCD, 0x5C, 0x2E, 0xBF,
+    0x90, 0x01, 0x73, 0xE2, 0x97, 0x06, 0x74, 0xE5, 0x9E, 0x0F, 0x7D, 0xEC, 0x99, 0x08, 0x7A, 0xEB,
+    0x8C, 0x1D, 0x6F, 0xFE, 0x8B, 0x1A, 0x68, 0xF9, 0x82, 0x13, 0x61, 0xF0, 0x85, 0x14, 0x66, 0xF7,
+    0xA8, 0x39, 0x4B, 0xDA, 0xAF, 0x3E, 0x4C, 0xDD, 0xA6, 0x37, 0x45, 0xD4, 0xA1, 0x30, 0x42, 0xD3,
+    0xB4, 0x25, 0x57, 0xC6, 0xB3, 0x22, 0x50, 0xC1, 0xBA, 0x2B, 0x59, 0xC8, 0xBD, 0x2C, 0x5E, 0xCF};
+
+// Channel
+
+SparkFun_ublox_Cellular_CMUX_Channel::SparkFun_ublox_Cellular_CMUX_Channel()
+{
+    _mux = nullptr;
+    _dlci = 0;
+    _state = UBX_CELL_CMUX_CHANNEL_CLOSED;
+    _remoteFlowStop = false;
+    _localFlowStop = false;
+    _rxHead = 0;
+    _rxTail = 0;
+    _rxUsed = 0;
+    _rxOverruns = 0;
+}
+
+void SparkFun_ublox_Cellular_CMUX_Channel::begin(unsigned long baud)
+{
+    (void)baud;
+}
+
+void SparkFun_ublox_Cellular_CMUX_Channel::end(void)
+{
+}
+
+int SparkFun_ublox_Cellular_CMUX_Channel::available(void)
+{
+    _mux->service();
+    if ((_rxUsed == 0) && (_state != UBX_CELL_CMUX_CHANNEL_OPEN))
+        return -1;
+    return _rxUsed;
+}
+
+size_t SparkFun_ublox_Cellular_CMUX_Channel::read(char *dest, size_t len)
+{
+    if (_rxUsed == 0)
+        _mux->service();
+
+    size_t numRead = 0;
+    while ((numRead < len) && (_rxUsed > 0))
+    {
+        size_t chunk = UBX_CELL_CMUX_RX_BUFFER_SIZE - _rxTail; // Up to the end of the buffer
+        if (chunk > (size_t)_rxUsed)
+            chunk = _rxUsed;
+        if (chunk > len - numRead)
+            chunk = len - numRead;
+        memcpy(&dest[numRead], &_rx[_rxTail], chunk);
+        numRead += chunk;
+        _rxUsed -= chunk;
+        _rxTail = (_rxTail + chunk) % UBX_CELL_CMUX_RX_BUFFER_SIZE;
+    }
+
+    // Let the module send again once the buffer has drained
+    if (_localFlowStop && (_rxUsed < (UBX_CELL_CMUX_RX_BUFFER_SIZE / 4)))
+    {
+        _localFlowStop = false;
+        _mux->writeMSC(_dlci, false);
+    }
+
+    return numRead;
+}
+
+size_t SparkFun_ublox_Cellular_CMUX_Channel::write(const char *src, size_t len)
+{
+    size_t written = 0;
+    while ((written < len) && (_state == UBX_CELL_CMUX_CHANNEL_OPEN))
+    {
+        // Hold off while the module has asked us to
+        unsigned long timeIn = millis();
+        while (_remoteFlowStop && (millis() - timeIn < UBX_CELL_CMUX_TIMEOUT))
+        {
+            _mux->service();
+            yield();
+        }
+        if (_remoteFlowStop)
+            break;
+
+        size_t chunk = len - written;
+        if (chunk > UBX_CELL_CMUX_FRAME_SIZE)
+            chunk = UBX_CELL_CMUX_FRAME_SIZE;
+        if (!_mux->writeFrame(_dlci, UBX_CELL_CMUX_UIH, &src[written], chunk))
+            break;
+        written += chunk;
+    }
+    return written;
+}
+
+void SparkFun_ublox_Cellular_CMUX_Channel::receive(const char *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if (_rxUsed == UBX_CELL_CMUX_RX_BUFFER_SIZE)
+        {
+            _rxOverruns += len - i;
+            break;
+        }
+        _rx[_rxHead] = data[i];
+        _rxHead = (_rxHead + 1) % UBX_CELL_CMUX_RX_BUFFER_SIZE;
+        _rxUsed++;
+    }
+
+    // Ask the module to stop sending before the buffer overflows. It may still send a frame or two
+    if ((!_localFlowStop) && (_rxUsed > ((UBX_CELL_CMUX_RX_BUFFER_SIZE * 3) / 4)))
+    {
+        _localFlowStop = true;
+        _mux->writeMSC(_dlci, true);
+    }
+}
+
+// Multiplexer
+
+SparkFun_ublox_Cellular_CMUX::SparkFun_ublox_Cellular_CMUX(SparkFun_ublox_Cellular_Transport &link)
+{
+    _transport = &link;
+    _stream = nullptr;
+    init();
+}
+
+SparkFun_ublox_Cellular_CMUX::SparkFun_ublox_Cellular_CMUX(Stream &link)
+{
+    _transport = nullptr;
+    _stream = &link;
+    init();
+}
+
+void SparkFun_ublox_Cellular_CMUX::init(void)
+{
+    for (int i = 0; i < UBX_CELL_CMUX_MAX_CHANNELS; i++)
+    {
+        _channels[i]._mux = this;
+        _channels[i]._dlci = i;
+    }
+    _rxState = UBX_CELL_CMUX_HUNT;
+    _rxAddress = 0;
+    _rxControl = 0;
+    _rxFCS = 0;
+    _rxLength = 0;
+    _rxIndex = 0;
+    _servicing = false;
+    _fcsErrors = 0;
+}
+
+bool SparkFun_ublox_Cellular_CMUX::begin(int numChannels)
+{
+    if (numChannels > UBX_CELL_CMUX_MAX_CHANNELS - 1)
+        numChannels = UBX_CELL_CMUX_MAX_CHANNELS - 1;
+
+    _rxState = UBX_CELL_CMUX_HUNT;
+
+    if (!openChannel(0))
+        return false;
+
+    bool success = true;
+    for (int dlci = 1; dlci <= numChannels; dlci++)
+    {
+        if (openChannel(dlci))
+            writeMSC(dlci, false); // Tell the module we are ready: DV, RTC and RTR set
+        else
+            success = false;
+    }
+    return success;
+}
+
+void SparkFun_ublox_Cellular_CMUX::end(void)
+{
+    if (!isOpen())
+        return;
+
+    // CLD closes every DLC at once. The module acknowledges it with a CLD response
+    _channels[0]._state = SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_CLOSING;
+    writeControl(UBX_CELL_CMUX_MSG_CLD, nullptr, 0);
+    waitForState(_channels[0], UBX_CELL_CMUX_TIMEOUT);
+
+    for (int i = 0; i < UBX_CELL_CMUX_MAX_CHANNELS; i++)
+        _channels[i]._state = SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_CLOSED;
+}
+
+SparkFun_ublox_Cellular_CMUX_Channel &SparkFun_ublox_Cellular_CMUX::channel(int dlci)
+{
+    if ((dlci < 0) || (dlci >= UBX_CELL_CMUX_MAX_CHANNELS))
+        dlci = UBX_CELL_CMUX_CONTROL_CHANNEL;
+    return _channels[dlci];
+}
+
+void SparkFun_ublox_Cellular_CMUX::service(void)
+{
+    if (_servicing)
+        return;
+    _servicing = true;
+
+    char buf[64];
+    size_t numRead;
+    while ((numRead = linkRead(buf, sizeof(buf))) > 0)
+    {
+        for (size_t i = 0; i < numRead; i++)
+            receive((uint8_t)buf[i]);
+    }
+
+    _servicing = false;
+}
+
+uint8_t SparkFun_ublox_Cellular_CMUX::fcs(uint8_t crc, uint8_t c)
+{
+    return UBX_CELL_CMUX_CRC_TABLE[crc ^ c];
+}
+
+size_t SparkFun_ublox_Cellular_CMUX::linkRead(char *dest, size_t len)
+{
+    if (_stream != nullptr)
+    {
+        int avail = _stream->available();
+        if (avail <= 0)
+            return 0;
+        if ((size_t)avail < len)
+            len = avail;
+        return _stream->readBytes(dest, len);
+    }
+    else if (_transport != nullptr)
+    {
+        return _transport->read(dest, len);
+    }
+    return 0;
+}
+
+size_t SparkFun_ublox_Cellular_CMUX::linkWritev(const UBX_CELL_iovec_t *iov, int count)
+{
+    if (_stream != nullptr)
+    {
+        size_t written = 0;
+        for (int i = 0; i < count; i++)
+            written += _stream->write((const uint8_t *)iov[i].data, iov[i].len);
+        return written;
+    }
+    else if (_transport != nullptr)
+    {
+        return _transport->writev(iov, count);
+    }
+    return 0;
+}
+
+bool SparkFun_ublox_Cellular_CMUX::writeFrame(uint8_t dlci, uint8_t control, const char *data, size_t len,
+                                              bool command)
+{
+    char header[5];
+    size_t headerLen = 0;
+    header[headerLen++] = (char)UBX_CELL_CMUX_FLAG;
+    header[headerLen++] = (char)((dlci << 2) | (command ? UBX_CELL_CMUX_CR : 0) | UBX_CELL_CMUX_EA);
+    header[headerLen++] = (char)control;
+    if (len > 127)
+    {
+        header[headerLen++] = (char)((len & 0x7F) << 1);
+        header[headerLen++] = (char)(len >> 7);
+    }
+    else
+    {
+        header[headerLen++] = (char)((len << 1) | UBX_CELL_CMUX_EA);
+    }
+
+    // UIH frames are checked over the address, control and length fields only
+    uint8_t crc = 0xFF;
+    for (size_t i = 1; i < headerLen; i++)
+        crc = fcs(crc, (uint8_t)header[i]);
+    if ((control & ~UBX_CELL_CMUX_PF) == UBX_CELL_CMUX_UI)
+    {
+        for (size_t i = 0; i < len; i++)
+            crc = fcs(crc, (uint8_t)data[i]);
+    }
+
+    char trailer[2];
+    trailer[0] = (char)(0xFF - crc);
+    trailer[1] = (char)UBX_CELL_CMUX_FLAG;
+
+    UBX_CELL_iovec_t iov[3] = {{header, headerLen}, {data, len}, {trailer, sizeof(trailer)}};
+    return linkWritev(iov, 3) == headerLen + len + sizeof(trailer);
+}
+
+bool SparkFun_ublox_Cellular_CMUX::writeControl(uint8_t type, const char *values, size_t len, bool command)
+{
+    char msg[2 + 8];
+    if (len > 8)
+        return false;
+    msg[0] = (char)(type | (command ? UBX_CELL_CMUX_CR : 0));
+    msg[1] = (char)((len << 1) | UBX_CELL_CMUX_EA);
+    if (len > 0)
+        memcpy(&msg[2], values, len);
+    return writeFrame(0, UBX_CELL_CMUX_UIH, msg, 2 + len);
+}
+
+bool SparkFun_ublox_Cellular_CMUX::writeMSC(uint8_t dlci, bool flowStop)
+{
+    char values[2];
+    values[0] = (char)((dlci << 2) | UBX_CELL_CMUX_CR | UBX_CELL_CMUX_EA);
+    values[1] = (char)(UBX_CELL_CMUX_MSC_DV | UBX_CELL_CMUX_MSC_RTR | UBX_CELL_CMUX_MSC_RTC | UBX_CELL_CMUX_EA);
+    if (flowStop)
+        values[1] |= UBX_CELL_CMUX_MSC_FC;
+    return writeControl(UBX_CELL_CMUX_MSG_MSC, values, sizeof(values));
+}
+
+bool SparkFun_ublox_Cellular_CMUX::openChannel(uint8_t dlci)
+{
+    SparkFun_ublox_Cellular_CMUX_Channel &ch = _channels[dlci];
+    ch._state = SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_OPENING;
+    ch._remoteFlowStop = false;
+    ch._localFlowStop = false;
+    if (!writeFrame(dlci, UBX_CELL_CMUX_SABM | UBX_CELL_CMUX_PF, nullptr, 0))
+    {
+        ch._state = SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_CLOSED;
+        return false;
+    }
+    if (!waitForState(ch, UBX_CELL_CMUX_TIMEOUT))
+        ch._state = SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_CLOSED;
+    return ch.isOpen();
+}
+
+bool SparkFun_ublox_Cellular_CMUX::waitForState(SparkFun_ublox_Cellular_CMUX_Channel &channel, unsigned long timeout)
+{
+    unsigned long timeIn = millis();
+    while ((channel._state == SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_OPENING) ||
+           (channel._state == SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_CLOSING))
+    {
+        if (millis() - timeIn >= timeout)
+            return false;
+        service();
+        yield();
+    }
+    return true;
+}
+
+void SparkFun_ublox_Cellular_CMUX::receive(uint8_t c)
+{
+    switch (_rxState)
+    {
+    case UBX_CELL_CMUX_HUNT:
+        if (c == UBX_CELL_CMUX_FLAG)
+            _rxState = UBX_CELL_CMUX_ADDRESS;
+        break;
+    case UBX_CELL_CMUX_ADDRESS:
+        if (c == UBX_CELL_CMUX_FLAG) // Idle flags between frames
+            break;
+        _rxAddress = c;
+        _rxFCS = fcs(0xFF, c);
+        _rxState = UBX_CELL_CMUX_CONTROL;
+        break;
+    case UBX_CELL_CMUX_CONTROL:
+        _rxControl = c;
+        _rxFCS = fcs(_rxFCS, c);
+        _rxState = UBX_CELL_CMUX_LENGTH;
+        break;
+    case UBX_CELL_CMUX_LENGTH:
+    case UBX_CELL_CMUX_LENGTH2:
+        _rxFCS = fcs(_rxFCS, c);
+        if (_rxState == UBX_CELL_CMUX_LENGTH)
+            _rxLength = c >> 1;
+        else
+            _rxLength |= ((size_t)c) << 7;
+        _rxIndex = 0;
+        if ((_rxState == UBX_CELL_CMUX_LENGTH) && ((c & UBX_CELL_CMUX_EA) == 0))
+            _rxState = UBX_CELL_CMUX_LENGTH2;
+        else if (_rxLength > UBX_CELL_CMUX_FRAME_SIZE)
+        {
+            _fcsErrors++;
+            _rxState = UBX_CELL_CMUX_HUNT;
+        }
+        else
+            _rxState = (_rxLength > 0) ? UBX_CELL_CMUX_DATA : UBX_CELL_CMUX_FCS;
+        break;
+    case UBX_CELL_CMUX_DATA:
+        _rxFrame[_rxIndex++] = (char)c;
+        if (_rxIndex == _rxLength)
+            _rxState = UBX_CELL_CMUX_FCS;
+        break;
+    case UBX_CELL_CMUX_FCS:
+        if ((_rxControl & ~UBX_CELL_CMUX_PF) == UBX_CELL_CMUX_UI)
+        {
+            for (size_t i = 0; i < _rxLength; i++)
+                _rxFCS = fcs(_rxFCS, (uint8_t)_rxFrame[i]);
+        }
+        _rxFCS = fcs(_rxFCS, c);
+        _rxState = UBX_CELL_CMUX_END;
+        break;
+    case UBX_CELL_CMUX_END:
+        if ((c == UBX_CELL_CMUX_FLAG) && (_rxFCS == UBX_CELL_CMUX_FCS_GOOD))
+        {
+            processFrame();
+            _rxState = UBX_CELL_CMUX_ADDRESS; // The closing flag can also open the next frame
+        }
+        else
+        {
+            _fcsErrors++;
+            _rxState = (c == UBX_CELL_CMUX_FLAG) ? UBX_CELL_CMUX_ADDRESS : UBX_CELL_CMUX_HUNT;
+        }
+        break;
+    }
+}
+
+void SparkFun_ublox_Cellular_CMUX::processFrame(void)
+{
+    uint8_t dlci = _rxAddress >> 2;
+    uint8_t control = _rxControl & ~UBX_CELL_CMUX_PF;
+
+    if (dlci >= UBX_CELL_CMUX_MAX_CHANNELS)
+    {
+        if (control == UBX_CELL_CMUX_SABM) // Refuse channels we have no room for
+            writeFrame(dlci, UBX_CELL_CMUX_DM | UBX_CELL_CMUX_PF, nullptr, 0, false);
+        return;
+    }
+
+    SparkFun_ublox_Cellular_CMUX_Channel &ch = _channels[dlci];
+    switch (control)
+    {
+    case UBX_CELL_CMUX_UA:
+        if (ch._state == SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_OPENING)
+            ch._state = SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_OPEN;
+        else if (ch._state == SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_CLOSING)
+            ch._state = SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_CLOSED;
+        break;
+    case UBX_CELL_CMUX_DM:
+        if (ch._state == SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_OPENING)
+            ch._state = SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_REJECTED;
+        else
+            ch._state = SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_CLOSED;
+        break;
+    case UBX_CELL_CMUX_SABM:
+        ch._state = SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_OPEN;
+        writeFrame(dlci, UBX_CELL_CMUX_UA | UBX_CELL_CMUX_PF, nullptr, 0, false);
+        break;
+    case UBX_CELL_CMUX_DISC:
+        writeFrame(dlci, UBX_CELL_CMUX_UA | UBX_CELL_CMUX_PF, nullptr, 0, false);
+        if (dlci == 0) // Closing the control channel closes them all
+        {
+            for (int i = 0; i < UBX_CELL_CMUX_MAX_CHANNELS; i++)
+                _channels[i]._state = SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_CLOSED;
+        }
+        else
+            ch._state = SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_CLOSED;
+        break;
+    case UBX_CELL_CMUX_UIH:
+    case UBX_CELL_CMUX_UI:
+        if (dlci == 0)
+            processControl((const uint8_t *)_rxFrame, _rxLength);
+        else
+            ch.receive(_rxFrame, _rxLength);
+        break;
+    default:
+        break;
+    }
+}
+
+void SparkFun_ublox_Cellular_CMUX::processControl(const uint8_t *msg, size_t len)
+{
+    if (len < 2)
+        return;
+
+    uint8_t type = msg[0] & ~UBX_CELL_CMUX_CR;
+    bool command = (msg[0] & UBX_CELL_CMUX_CR) != 0;
+    size_t valuesLen = msg[1] >> 1;
+    const uint8_t *values = &msg[2];
+    if (valuesLen > len - 2)
+        return;
+
+    switch (type)
+    {
+    case UBX_CELL_CMUX_MSG_MSC:
+        if (command && (valuesLen >= 2))
+        {
+            uint8_t dlci = values[0] >> 2;
+            if ((dlci > 0) && (dlci < UBX_CELL_CMUX_MAX_CHANNELS))
+                _channels[dlci]._remoteFlowStop = (values[1] & UBX_CELL_CMUX_MSC_FC) != 0;
+            writeControl(UBX_CELL_CMUX_MSG_MSC, (const char *)values, valuesLen, false); // Acknowledge it
+        }
+        break;
+    case UBX_CELL_CMUX_MSG_CLD:
+        for (int i = 0; i < UBX_CELL_CMUX_MAX_CHANNELS; i++)
+            _channels[i]._state = SparkFun_ublox_Cellular_CMUX_Channel::UBX_CELL_CMUX_CHANNEL_CLOSED;
+        if (command)
+            writeControl(UBX_CELL_CMUX_MSG_CLD, nullptr, 0, false);
+        break;
+    case UBX_CELL_CMUX_MSG_TEST:
+        if (command)
+            writeControl(UBX_CELL_CMUX_MSG_TEST, (const char *)values, valuesLen, false); // Echo it back
+        break;
+    default:
+        if (command) // Anything else: not supported
+        {
+            char nsc = (char)msg[0];
+            writeControl(UBX_CELL_CMUX_MSG_NSC, &nsc, 1, false);
+        }
+        break;
+    }
+}
@@ -0,0 +1,150 @@
+#ifndef SFE_UBLOX_CELLULAR_CMUX_H
+#define SFE_UBLOX_CELLULAR_CMUX_H
+
+#include "sfe_ublox_cellular_transport.h"
+
+#define UBX_CELL_CMUX_MAX_CHANNELS 4    // DLC 0 (multiplexer control) plus three virtual channels
+#define UBX_CELL_CMUX_CONTROL_CHANNEL 1 // AT commands and their responses
+#define UBX_CELL_CMUX_URC_CHANNEL 2     // Unsolicited result codes
+#define UBX_CELL_CMUX_DATA_CHANNEL 3    // Bulk transfers: socket and file reads, PPP
+#define UBX_CELL_CMUX_FRAME_SIZE 127    // N1: the largest information field. Passed to the module in +CMUX
+#define UBX_CELL_CMUX_RX_BUFFER_SIZE 1024
+#define UBX_CELL_CMUX_TIMEOUT 1000 // T1: milliseconds to wait for the module to acknowledge SABM / DISC / CLD
+
+class SparkFun_ublox_Cellular_CMUX;
+
+// One virtual channel (DLC) of a multiplexer. It is a transport: pass it to SparkFun_ublox_Cellular::begin to run a
+// driver instance on that channel only
+class SparkFun_ublox_Cellular_CMUX_Channel : public SparkFun_ublox_Cellular_Transport
+{
+  public:
+    SparkFun_ublox_Cellular_CMUX_Channel();
+
+    bool isOpen(void)
+    {
+        return _state == UBX_CELL_CMUX_CHANNEL_OPEN;
+    }
+    unsigned long rxOverruns(void) // Bytes dropped because the channel's RX buffer was full
+    {
+        return _rxOverruns;
+    }
+
+    // The baud rate belongs to the physical link, so begin and end are ignored
+    void begin(unsigned long baud) override;
+    void end(void) override;
+    int available(void) override;
+    size_t read(char *dest, size_t len) override;
+    size_t write(const char *src, size_t len) override; // Split into UIH frames of up to UBX_CELL_CMUX_FRAME_SIZE
+
+  protected:
+    friend class SparkFun_ublox_Cellular_CMUX;
+
+    typedef enum
+    {
+        UBX_CELL_CMUX_CHANNEL_CLOSED = 0,
+        UBX_CELL_CMUX_CHANNEL_OPENING,
+        UBX_CELL_CMUX_CHANNEL_OPEN,
+        UBX_CELL_CMUX_CHANNEL_CLOSING,
+        UBX_CELL_CMUX_CHANNEL_REJECTED
+    } UBX_CELL_cmux_channel_state_t;
+
+    SparkFun_ublox_Cellular_CMUX *_mux;
+    uint8_t _dlci;
+    volatile UBX_CELL_cmux_channel_state_t _state;
+    bool _remoteFlowStop; // The module has asked us to stop sending (MSC FC)
+    bool _localFlowStop;  // We have asked the module to stop sending because _rx is nearly full
+
+    char _rx[UBX_CELL_CMUX_RX_BUFFER_SIZE];
+    int _rxHead;
+    int _rxTail;
+    int _rxUsed;
+    unsigned long _rxOverruns;
+
+    void receive(const char *data, size_t len);
+};
+
+// 3GPP TS 27.010 multiplexer (basic option, UIH frames) over a single serial link.
+// Each virtual channel is a separate AT interface on the module, so a long +URDFILE or +USORD response on one channel
+// does not hold up commands or URCs on the others. Typical use:
+//   SparkFun_ublox_Cellular_CMUX mux(Serial1);
+//   control.begin(Serial1); control.startMux(mux);             // control is now on UBX_CELL_CMUX_CONTROL_CHANNEL
+//   data.begin(mux.channel(UBX_CELL_CMUX_DATA_CHANNEL));        // a second driver instance for bulk transfers
+// Frames for every channel are read whenever any channel is read, so each channel is buffered until its owner gets to
+// it. MSC flow control stops the module sending on a channel whose buffer is nearly full.
+class SparkFun_ublox_Cellular_CMUX
+{
+  public:
+    SparkFun_ublox_Cellular_CMUX(SparkFun_ublox_Cellular_Transport &link);
+    SparkFun_ublox_Cellular_CMUX(Stream &link);
+
+    // Open the control DLC and channels 1 to numChannels. The module must already be in multiplexer mode (+CMUX=0);
+    // SparkFun_ublox_Cellular::startMux does both. Returns true if the module accepted every channel
+    bool begin(int numChannels = UBX_CELL_CMUX_MAX_CHANNELS - 1);
+    // Close every channel and leave multiplexer mode (CLD). The link is back in plain AT command mode afterwards
+    void end(void);
+    bool isOpen(void)
+    {
+        return _channels[0].isOpen();
+    }
+
+    SparkFun_ublox_Cellular_CMUX_Channel &channel(int dlci);
+
+    // Read whatever the link has and deliver it to the channels. Called by the channels; call it directly if no
+    // channel is being read for a while, so that frames do not back up in the link
+    void service(void);
+
+    unsigned long fcsErrors(void) // Frames discarded because of a bad checksum or length
+    {
+        return _fcsErrors;
+    }
+
+  protected:
+    friend class SparkFun_ublox_Cellular_CMUX_Channel;
+
+    typedef enum
+    {
+        UBX_CELL_CMUX_HUNT = 0,
+        UBX_CELL_CMUX_ADDRESS,
+        UBX_CELL_CMUX_CONTROL,
+        UBX_CELL_CMUX_LENGTH,
+        UBX_CELL_CMUX_LENGTH2,
+        UBX_CELL_CMUX_DATA,
+        UBX_CELL_CMUX_FCS,
+        UBX_CELL_CMUX_END
+    } UBX_CELL_cmux_rx_state_t;
+
+    SparkFun_ublox_Cellular_Transport *_transport;
+    Stream *_stream;
+
+    SparkFun_ublox_Cellular_CMUX_Channel _channels[UBX_CELL_CMUX_MAX_CHANNELS];
+
+    // Frame being received
+    UBX_CELL_cmux_rx_state_t _rxState;
+    uint8_t _rxAddress;
+    uint8_t _rxControl;
+    uint8_t _rxFCS;
+    size_t _rxLength;
+    size_t _rxIndex;
+    char _rxFrame[UBX_CELL_CMUX_FRAME_SIZE];
+    bool _servicing; // Stops service re-entering itself via the replies it sends
+
+    unsigned long _fcsErrors;
+
+    void init(void);
+    static uint8_t fcs(uint8_t crc, uint8_t c);
+
+    size_t linkRead(char *dest, size_t len);
+    size_t linkWritev(const UBX_CELL_iovec_t *iov, int count);
+
+    bool writeFrame(uint8_t dlci, uint8_t control, const char *data, size_t len, bool command = true);
+    bool writeControl(uint8_t type, const char *values, size_t len, bool command = true); // A message on DLC 0
+    bool writeMSC(uint8_t dlci, bool flowStop);
+    bool openChannel(uint8_t dlci);
+    bool waitForState(SparkFun_ublox_Cellular_CMUX_Channel &channel, unsigned long timeout);
+
+    void receive(uint8_t c);
+    void processFrame(void);
+    void processControl(const uint8_t *msg, size_t len);
+};
+
+#endif // SFE_UBLOX_CELLULAR_CMUX_H
@@ -0,0 +1,151 @@
+#include "sfe_ublox_cellular_command.h"
+#include "sfe_ublox_cellular_hex.h"
+
+SparkFun_ublox_Cellular_Command::SparkFun_ublox_Cellular_Command(char *buf, size_t size)
+{
+    _buf = buf;
+    _size = size;
+    begin("", false);
+}
+
+SparkFun_ublox_Cellular_Command &SparkFun_ublox_Cellular_Command::begin(const char *name, bool set)
+{
+    _length = 0;
+    _first = true;
+    _overflow = (_size == 0);
+    if (_size > 0)
+        _buf[0] = '\0';
+    append(name, strlen(name));
+    if (set)
+        append("=", 1);
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Command &SparkFun_ublox_Cellular_Command::argSigned(long value)
+{
+    separator();
+    if (value < 0)
+    {
+        append("-", 1);
+        appendDecimal(0UL - (unsigned long)value);
+    }
+    else
+    {
+        appendDecimal((unsigned long)value);
+    }
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Command &SparkFun_ublox_Cellular_Command::argUnsigned(unsigned long value)
+{
+    separator();
+    appendDecimal(value);
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Command &SparkFun_ublox_Cellular_Command::arg(const char *text)
+{
+    separator();
+    append(text, strlen(text));
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Command &SparkFun_ublox_Cellular_Command::arg(IPAddress address)
+{
+    separator();
+    appendIP(address);
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Command &SparkFun_ublox_Cellular_Command::quoted(const char *text, size_t len)
+{
+    separator();
+    append("\"", 1);
+    append(text, len);
+    append("\"", 1);
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Command &SparkFun_ublox_Cellular_Command::quoted(const char *text)
+{
+    return quoted(text, strlen(text));
+}
+
+SparkFun_ublox_Cellular_Command &SparkFun_ublox_Cellular_Command::quoted(const String &text)
+{
+    return quoted(text.c_str(), text.length());
+}
+
+SparkFun_ublox_Cellular_Command &SparkFun_ublox_Cellular_Command::quoted(IPAddress address)
+{
+    separator();
+    append("\"", 1);
+    appendIP(address);
+    append("\"", 1);
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Command &SparkFun_ublox_Cellular_Command::hex(const char *data, size_t len)
+{
+    separator();
+    append("\"", 1);
+    if ((!_overflow) && (2 * len < _size - _length)) // Encoded straight into the buffer
+    {
+        _length += SparkFun_ublox_Cellular_Hex::encode(data, len, &_buf[_length]);
+        _buf[_length] = '\0';
+    }
+    else
+    {
+        _overflow = true;
+    }
+    append("\"", 1);
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Command &SparkFun_ublox_Cellular_Command::raw(const char *text, size_t len)
+{
+    append(text, len);
+    return *this;
+}
+
+void SparkFun_ublox_Cellular_Command::separator(void)
+{
+    if (!_first)
+        append(",", 1);
+    _first = false;
+}
+
+// Add text and keep the buffer NULL-terminated. If it does not all fit, none of it is added
+void SparkFun_ublox_Cellular_Command::append(const char *text, size_t len)
+{
+    if (_overflow || (len >= _size - _length))
+    {
+        _overflow = true;
+        return;
+    }
+    memcpy(&_buf[_length], text, len);
+    _length += len;
+    _buf[_length] = '\0';
+}
+
+void SparkFun_ublox_Cellular_Command::appendDecimal(unsigned long value)
+{
+    char digits[sizeof(unsigned long) * 3]; // Enough for any unsigned long
+    size_t n = sizeof(digits);
+    do
+    {
+        digits[--n] = '0' + (value % 10);
+        value /= 10;
+    } while (value > 0);
+    append(&digits[n], sizeof(digits) - n);
+}
+
+void SparkFun_ublox_Cellular_Command::appendIP(IPAddress address)
+{
+    for (int i = 0; i < 4; i++)
+    {
+        if (i > 0)
+            append(".", 1);
+        appendDecimal(address[i]);
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef SFE_UBLOX_CELLULAR_COMMAND_H
+#define SFE_UBLOX_CELLULAR_COMMAND_H
+
+#if (ARDUINO >= 100)
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include <IPAddress.h>
+#include <type_traits>
+
+// Builds an AT command (without the "AT" and the terminator) in a buffer owned by the caller, with no heap and no
+// printf. Each parameter is appended with the comma before it, e.g.
+//   SparkFun_ublox_Cellular_Command command(buf);
+//   command.begin(UBX_CELL_HTTP_PROFILE).arg(profile).arg(UBX_CELL_HTTP_OP_CODE_SERVER_NAME).quoted(server);
+// gives +UHTTP=0,1,"example.com". Anything which does not fit is dropped and overflow() returns true.
+class SparkFun_ublox_Cellular_Command
+{
+  public:
+    SparkFun_ublox_Cellular_Command(char *buf, size_t size);
+    template <size_t N> SparkFun_ublox_Cellular_Command(char (&buf)[N]) : SparkFun_ublox_Cellular_Command(buf, N)
+    {
+    }
+
+    // Start again with the command name, followed by = if it has parameters
+    SparkFun_ublox_Cellular_Command &begin(const char *name, bool set = true);
+
+    // Parameters
+    template <typename T> SparkFun_ublox_Cellular_Command &arg(T value) // Any integer or enum
+    {
+        static_assert(std::is_integral<T>::value || std::is_enum<T>::value, "arg: use quoted for strings");
+        return std::is_signed<T>::value ? argSigned((long)value) : argUnsigned((unsigned long)value);
+    }
+    SparkFun_ublox_Cellular_Command &arg(const char *text); // As it is, without quotes
+    SparkFun_ublox_Cellular_Command &arg(IPAddress address); // a.b.c.d
+    SparkFun_ublox_Cellular_Command &quoted(const char *text, size_t len);
+    SparkFun_ublox_Cellular_Command &quoted(const char *text);
+    SparkFun_ublox_Cellular_Command &quoted(const String &text);
+    SparkFun_ublox_Cellular_Command &quoted(IPAddress address); // "a.b.c.d"
+    SparkFun_ublox_Cellular_Command &hex(const char *data, size_t len); // "48656C6C6F": binary data in hex mode
+    SparkFun_ublox_Cellular_Command &raw(const char *text, size_t len); // No comma, no quotes: e.g. text after a prompt
+
+    bool overflow(void) // The command did not fit in the buffer
+    {
+        return _overflow;
+    }
+    const char *c_str(void)
+    {
+        return _buf;
+    }
+    size_t length(void)
+    {
+        return _length;
+    }
+
+  protected:
+    char *_buf;
+    size_t _size;
+    size_t _length;
+    bool _first; // No comma before the next parameter
+    bool _overflow;
+
+    SparkFun_ublox_Cellular_Command &argSigned(long value);
+    SparkFun_ublox_Cellular_Command &argUnsigned(unsigned long value);
+    void separator(void);
+    void append(const char *text, size_t len);
+    void appendDecimal(unsigned long value);
+    void appendIP(IPAddress address);
+};
+
+#endif // SFE_UBLOX_CELLULAR_COMMAND_H
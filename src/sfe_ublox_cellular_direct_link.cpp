@@ -0,0 +1,196 @@
+#include "sfe_ublox_cellular_direct_link.h"
+
+SparkFun_ublox_Cellular_DirectLink::SparkFun_ublox_Cellular_DirectLink(SparkFun_ublox_Cellular &cell)
+{
+    _cell = &cell;
+    _socket = -1;
+    _guardTime = UBX_CELL_DIRECT_LINK_GUARD_TIME;
+    _lastWrite = 0;
+    _rxHead = 0;
+    _rxTail = 0;
+    _match = 0;
+    _matchAt = 0;
+}
+
+UBX_CELL_error_t SparkFun_ublox_Cellular_DirectLink::begin(int socket)
+{
+    if (_socket >= 0)
+        return UBX_CELL_ERROR_INVALID;
+
+    UBX_CELL_error_t err = _cell->socketDirectLinkMode(socket);
+    if (err != UBX_CELL_ERROR_SUCCESS)
+        return err;
+
+    // Anything which arrived after CONNECT is still staged in the driver. fill will collect it
+    _socket = socket;
+    _match = 0;
+    _lastWrite = millis();
+    return UBX_CELL_ERROR_SUCCESS;
+}
+
+UBX_CELL_error_t SparkFun_ublox_Cellular_DirectLink::end(void)
+{
+    if (_socket < 0)
+        return UBX_CELL_ERROR_INVALID;
+
+    _cell->txFlush(UBX_CELL_SOCKET_WRITE_TIMEOUT);
+
+    // Keep collecting data during the guard times, so it can still be read after end
+    while ((_socket >= 0) && (millis() - _lastWrite < _guardTime))
+    {
+        fill();
+        yield();
+    }
+    if (_socket < 0) // NO CARRIER: the module has already left Direct Link mode
+        return UBX_CELL_ERROR_SUCCESS;
+
+    // Anything held back as a possible NO CARRIER was data after all
+    memcpy(&_rx[_rxTail], UBX_CELL_RESPONSE_NO_CARRIER, _match);
+    _rxTail += _match;
+    _match = 0;
+
+    // The module replies once it has seen the second guard time. Anything which arrives before then is lost
+    _cell->hwWriteData("+++", 3);
+    _lastWrite = millis();
+    _socket = -1;
+
+    // Some firmware reports OK rather than DISCONNECT
+    UBX_CELL_error_t err = _cell->waitForResponse(UBX_CELL_RESPONSE_DISCONNECT, UBX_CELL_RESPONSE_OK,
+                                                  _guardTime + UBX_CELL_STANDARD_RESPONSE_TIMEOUT);
+    if (err == UBX_CELL_ERROR_ERROR)
+        err = UBX_CELL_ERROR_SUCCESS;
+    return err;
+}
+
+bool SparkFun_ublox_Cellular_DirectLink::connected(void)
+{
+    if (_socket >= 0)
+        fill(); // Look for NO CARRIER
+    return _socket >= 0;
+}
+
+void SparkFun_ublox_Cellular_DirectLink::setGuardTime(unsigned long guardTime)
+{
+    _guardTime = guardTime;
+}
+
+int SparkFun_ublox_Cellular_DirectLink::available(void)
+{
+    return fill();
+}
+
+int SparkFun_ublox_Cellular_DirectLink::read(void)
+{
+    if (fill() == 0)
+        return -1;
+    return (uint8_t)_rx[_rxHead++];
+}
+
+int SparkFun_ublox_Cellular_DirectLink::read(uint8_t *buf, size_t size)
+{
+    size_t numRead = 0;
+    while (numRead < size)
+    {
+        int avail = fill();
+        if (avail == 0)
+            break;
+        if ((size_t)avail > size - numRead)
+            avail = size - numRead;
+        memcpy(&buf[numRead], &_rx[_rxHead], avail);
+        _rxHead += avail;
+        numRead += avail;
+    }
+    return (int)numRead;
+}
+
+int SparkFun_ublox_Cellular_DirectLink::peek(void)
+{
+    if (fill() == 0)
+        return -1;
+    return (uint8_t)_rx[_rxHead];
+}
+
+size_t SparkFun_ublox_Cellular_DirectLink::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t SparkFun_ublox_Cellular_DirectLink::write(const uint8_t *buf, size_t size)
+{
+    if ((_socket < 0) || (size == 0))
+        return 0;
+    size_t written = _cell->hwWriteData((const char *)buf, (int)size);
+    _lastWrite = millis();
+    return written;
+}
+
+void SparkFun_ublox_Cellular_DirectLink::flush(void)
+{
+    _cell->txFlush(UBX_CELL_SOCKET_WRITE_TIMEOUT);
+}
+
+int SparkFun_ublox_Cellular_DirectLink::fill(void)
+{
+    if (_rxHead == _rxTail)
+    {
+        _rxHead = 0;
+        _rxTail = 0;
+    }
+
+    // Leave room for a held partial match to be released as data
+    int space = UBX_CELL_DIRECT_LINK_BUFFER_SIZE - _rxTail - (int)strlen(UBX_CELL_RESPONSE_NO_CARRIER);
+    if ((_socket < 0) || (space <= 0))
+        return _rxTail - _rxHead;
+
+    char buf[32];
+    if (space > (int)sizeof(buf))
+        space = sizeof(buf);
+    int numRead = _cell->rxRead(buf, space);
+    for (int i = 0; i < numRead; i++)
+    {
+        if (_socket >= 0)
+            receive(buf[i]);
+        else
+            _cell->rxRingPut(buf[i]); // Back in command mode: leave URCs for bufferedPoll
+    }
+
+    // The module sends NO CARRIER in one go. If the rest has not followed, the bytes were data
+    if ((numRead == 0) && (_match > 0) && (millis() - _matchAt >= UBX_CELL_DIRECT_LINK_HOLD_TIME))
+    {
+        memcpy(&_rx[_rxTail], UBX_CELL_RESPONSE_NO_CARRIER, _match);
+        _rxTail += _match;
+        _match = 0;
+    }
+
+    return _rxTail - _rxHead;
+}
+
+// Pass c through to _rx, holding back anything which might be the start of NO CARRIER
+void SparkFun_ublox_Cellular_DirectLink::receive(char c)
+{
+    if (c == UBX_CELL_RESPONSE_NO_CARRIER[_match])
+    {
+        if (_match == 0)
+            _matchAt = millis();
+        if (UBX_CELL_RESPONSE_NO_CARRIER[++_match] == '\0')
+        {
+            _match = 0;
+            _socket = -1; // The module is back in command mode
+        }
+        return;
+    }
+
+    if (_match == 0)
+    {
+        _rx[_rxTail++] = c;
+        return;
+    }
+
+    // Release the first held byte as data, then see if the rest (and c) start a match
+    int held = _match;
+    _match = 0;
+    _rx[_rxTail++] = UBX_CELL_RESPONSE_NO_CARRIER[0];
+    for (int i = 1; i < held; i++)
+        receive(UBX_CELL_RESPONSE_NO_CARRIER[i]);
+    receive(c);
+}
@@ -0,0 +1,62 @@
+#ifndef SFE_UBLOX_CELLULAR_DIRECT_LINK_H
+#define SFE_UBLOX_CELLULAR_DIRECT_LINK_H
+
+#include "sfe_ublox_cellular.h"
+
+#define UBX_CELL_DIRECT_LINK_BUFFER_SIZE 128
+#define UBX_CELL_DIRECT_LINK_GUARD_TIME 2000 // Milliseconds of silence either side of the +++ escape (ATS12 is 1 s)
+#define UBX_CELL_DIRECT_LINK_HOLD_TIME 20    // Milliseconds a partial NO CARRIER is held back before it is treated as data
+
+// A socket in Direct Link mode (+USODL), as a Stream.
+// Once begin returns, bytes move between the Stream and the socket with no AT commands, prompts or quoting, so bulk
+// TCP transfers run at close to the line rate. While the link is up, the driver's other functions must not be used:
+// call end to send the +++ escape and get back to AT command mode. The socket stays open.
+// If the remote end closes the socket, the module sends NO CARRIER and leaves Direct Link mode by itself. connected()
+// then returns false and anything which arrived before it can still be read.
+class SparkFun_ublox_Cellular_DirectLink : public Stream
+{
+  public:
+    SparkFun_ublox_Cellular_DirectLink(SparkFun_ublox_Cellular &cell);
+
+    // Enter Direct Link mode on a connected socket. Returns when the module says CONNECT
+    UBX_CELL_error_t begin(int socket);
+    // Leave Direct Link mode with the +++ escape
+    UBX_CELL_error_t end(void);
+    bool connected(void);
+    int socket(void) // The socket in Direct Link mode, or -1
+    {
+        return _socket;
+    }
+    // Milliseconds of silence the module needs either side of +++. Must match ATS12 (in 20 ms units)
+    void setGuardTime(unsigned long guardTime);
+
+    // Stream
+    int available(void);
+    int read(void);
+    int read(uint8_t *buf, size_t size); // Read up to size bytes which are already available. Returns the number read
+    int peek(void);
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buf, size_t size);
+    void flush(void); // Wait for the driver's TX queue (if enabled) to empty
+    using Print::write;
+
+  protected:
+    SparkFun_ublox_Cellular *_cell;
+    int _socket;
+    unsigned long _guardTime;
+    unsigned long _lastWrite; // millis() of the last write, for the guard time before +++
+
+    // Data waiting to be read
+    char _rx[UBX_CELL_DIRECT_LINK_BUFFER_SIZE];
+    int _rxHead;
+    int _rxTail;
+
+    // How much of UBX_CELL_RESPONSE_NO_CARRIER has been seen, and when it started
+    int _match;
+    unsigned long _matchAt;
+
+    int fill(void); // Move any available bytes from the driver into _rx. Returns the number waiting in _rx
+    void receive(char c);
+};
+
+#endif // SFE_UBLOX_CELLULAR_DIRECT_LINK_H
@@ -0,0 +1,78 @@
+#include "sfe_ublox_cellular_hex.h"
+
+const char SparkFun_ublox_Cellular_Hex::_digits[513] =
+    "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F"
+    "202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F"
+    "404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F"
+    "606162636465666768696A6B6C6D6E6F707172737475767778797A7B7C7D7E7F"
+    "808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9F"
+    "A0A1A2A3A4A5A6A7A8A9AAABACADAEAFB0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+    "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECFD0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+    "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEFF0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+const uint8_t SparkFun_ublox_Cellular_Hex::_values[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+size_t SparkFun_ublox_Cellular_Hex::encode(const char *src, size_t len, char *dest)
+{
+    const uint8_t *in = (const uint8_t *)src;
+    size_t i = 0;
+
+    for (; i + 4 <= len; i += 4)
+    {
+        memcpy(&dest[(2 * i) + 0], &_digits[2 * in[i + 0]], 2);
+        memcpy(&dest[(2 * i) + 2], &_digits[2 * in[i + 1]], 2);
+        memcpy(&dest[(2 * i) + 4], &_digits[2 * in[i + 2]], 2);
+        memcpy(&dest[(2 * i) + 6], &_digits[2 * in[i + 3]], 2);
+    }
+    for (; i < len; i++)
+        memcpy(&dest[2 * i], &_digits[2 * in[i]], 2);
+
+    return 2 * len;
+}
+
+bool SparkFun_ublox_Cellular_Hex::decode(const char *src, size_t len, char *dest)
+{
+    const uint8_t *in = (const uint8_t *)src;
+    size_t i = 0;
+
+    for (; i + 4 <= len; i += 4)
+    {
+        const uint8_t *digits = &in[2 * i];
+        uint8_t h0 = _values[digits[0]], l0 = _values[digits[1]];
+        uint8_t h1 = _values[digits[2]], l1 = _values[digits[3]];
+        uint8_t h2 = _values[digits[4]], l2 = _values[digits[5]];
+        uint8_t h3 = _values[digits[6]], l3 = _values[digits[7]];
+        if ((h0 | l0 | h1 | l1 | h2 | l2 | h3 | l3) & 0xF0) // Only an invalid digit has any high bits
+            return false;
+        dest[i + 0] = (char)((h0 << 4) | l0);
+        dest[i + 1] = (char)((h1 << 4) | l1);
+        dest[i + 2] = (char)((h2 << 4) | l2);
+        dest[i + 3] = (char)((h3 << 4) | l3);
+    }
+    for (; i < len; i++)
+    {
+        uint8_t h = _values[in[2 * i]], l = _values[in[(2 * i) + 1]];
+        if ((h | l) & 0xF0)
+            return false;
+        dest[i] = (char)((h << 4) | l);
+    }
+
+    return true;
+}
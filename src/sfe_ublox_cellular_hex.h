@@ -0,0 +1,27 @@
+#ifndef SFE_UBLOX_CELLULAR_HEX_H
+#define SFE_UBLOX_CELLULAR_HEX_H
+
+#if (ARDUINO >= 100)
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+// Hex codec for the socket hex mode (+UDCONF=1,1), where socket data travels as two hex digits per byte.
+// Both directions are table driven and work on four bytes per iteration: each byte is one lookup when encoding, and
+// each pair of digits two lookups when decoding, with a single validity check for all eight digits.
+class SparkFun_ublox_Cellular_Hex
+{
+  public:
+    // Write len bytes from src to dest as 2 * len upper case hex digits. No NUL is added. Returns 2 * len
+    static size_t encode(const char *src, size_t len, char *dest);
+    // Read 2 * len hex digits (either case) from src into len bytes at dest. Returns false if any digit is not hex:
+    // dest then holds an unspecified part of the data
+    static bool decode(const char *src, size_t len, char *dest);
+
+  protected:
+    static const char _digits[513];    // "000102...FEFF": the two digits of each byte value
+    static const uint8_t _values[256]; // The value of each hex digit character, or 0xFF
+};
+
+#endif // SFE_UBLOX_CELLULAR_HEX_H
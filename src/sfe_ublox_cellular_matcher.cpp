@@ -0,0 +1,77 @@
+#include "sfe_ublox_cellular_matcher.h"
+
+SparkFun_ublox_Cellular_Matcher::SparkFun_ublox_Cellular_Matcher()
+{
+    clear();
+}
+
+int SparkFun_ublox_Cellular_Matcher::add(const char *pattern)
+{
+    if ((pattern == nullptr) || (pattern[0] == '\0') || (_count >= UBX_CELL_MATCHER_MAX_PATTERNS))
+        return -1;
+
+    size_t len = strlen(pattern);
+    if (len > UBX_CELL_MATCHER_MAX_LENGTH)
+    {
+        pattern += len - UBX_CELL_MATCHER_MAX_LENGTH;
+        len = UBX_CELL_MATCHER_MAX_LENGTH;
+    }
+
+    int p = _count;
+    _pattern[p] = pattern;
+    _length[p] = (uint8_t)len;
+    _matched[p] = 0;
+
+    // The usual KMP prefix function
+    uint8_t *fail = _fail[p];
+    fail[0] = 0;
+    uint8_t k = 0;
+    for (size_t i = 1; i < len; i++)
+    {
+        while ((k > 0) && (pattern[i] != pattern[k]))
+            k = fail[k - 1];
+        if (pattern[i] == pattern[k])
+            k++;
+        fail[i] = k;
+    }
+
+    _count++;
+    return p;
+}
+
+void SparkFun_ublox_Cellular_Matcher::clear(void)
+{
+    _count = 0;
+}
+
+void SparkFun_ublox_Cellular_Matcher::reset(void)
+{
+    for (int p = 0; p < _count; p++)
+        _matched[p] = 0;
+}
+
+int SparkFun_ublox_Cellular_Matcher::match(char c)
+{
+    int found = -1;
+
+    for (int p = 0; p < _count; p++)
+    {
+        const char *pattern = _pattern[p];
+        uint8_t k = _matched[p];
+
+        while ((k > 0) && (pattern[k] != c))
+            k = _fail[p][k - 1];
+        if (pattern[k] == c)
+            k++;
+
+        if (k == _length[p])
+        {
+            if (found < 0)
+                found = p;
+            k = _fail[p][k - 1];
+        }
+        _matched[p] = k;
+    }
+
+    return found;
+}
@@ -0,0 +1,42 @@
+#ifndef SFE_UBLOX_CELLULAR_MATCHER_H
+#define SFE_UBLOX_CELLULAR_MATCHER_H
+
+#if (ARDUINO >= 100)
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#define UBX_CELL_MATCHER_MAX_PATTERNS 4 // e.g. the expected response, the expected error and two prompts
+#define UBX_CELL_MATCHER_MAX_LENGTH 64  // Longer patterns are matched on their last UBX_CELL_MATCHER_MAX_LENGTH bytes
+
+// Looks for a set of fixed patterns (e.g. "\nOK\r\n", "\nERROR\r\n", "\n>") in a stream of bytes, one byte at a
+// time. Each pattern is matched with Knuth-Morris-Pratt, so a byte which breaks a partial match is still considered
+// as the start (or middle) of a new one. "\r\r\nOK\r\n" finds "\r\nOK\r\n", for example, where restarting from the
+// beginning of the pattern would miss it. Each byte is looked at once, with no buffering and no backing up.
+// The patterns are not copied: they must stay valid while the matcher is in use.
+class SparkFun_ublox_Cellular_Matcher
+{
+  public:
+    SparkFun_ublox_Cellular_Matcher();
+
+    // Add a pattern and build its failure table. Returns its index, or -1 if it is empty or there is no room
+    int add(const char *pattern);
+    // Remove every pattern
+    void clear(void);
+    // Forget any partial matches. The patterns stay
+    void reset(void);
+    // Feed the next byte. Returns the index of the pattern it completes, or -1. If several complete on the same
+    // byte, the one added first wins. Matching carries on from the completed match, so overlapping matches are found
+    int match(char c);
+
+  protected:
+    const char *_pattern[UBX_CELL_MATCHER_MAX_PATTERNS];
+    uint8_t _length[UBX_CELL_MATCHER_MAX_PATTERNS];
+    uint8_t _matched[UBX_CELL_MATCHER_MAX_PATTERNS]; // How many bytes of each pattern the input currently ends with
+    // _fail[p][i]: the length of the longest proper prefix of pattern p which is also a suffix of its first i + 1 bytes
+    uint8_t _fail[UBX_CELL_MATCHER_MAX_PATTERNS][UBX_CELL_MATCHER_MAX_LENGTH];
+    int _count;
+};
+
+#endif // SFE_UBLOX_CELLULAR_MATCHER_H
@@ -0,0 +1,272 @@
+#include "sfe_ublox_cellular_parser.h"
+
+SparkFun_ublox_Cellular_Parser::SparkFun_ublox_Cellular_Parser(const char *text)
+{
+    _pos = text;
+    _first = true;
+    _failed = (text == nullptr);
+    _count = 0;
+}
+
+SparkFun_ublox_Cellular_Parser &SparkFun_ublox_Cellular_Parser::find(const char *prefix)
+{
+    if (_failed)
+        return *this;
+    const char *found = strstr(_pos, prefix);
+    if (found == nullptr)
+    {
+        fail();
+        return *this;
+    }
+    _pos = found + strlen(prefix);
+    while (*_pos == ' ')
+        _pos++;
+    _first = true;
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Parser &SparkFun_ublox_Cellular_Parser::decimal(double &value)
+{
+    if (!separator())
+        return *this;
+
+    bool negative = (*_pos == '-');
+    if ((*_pos == '-') || (*_pos == '+'))
+        _pos++;
+    unsigned long whole;
+    if (!readDigits(whole))
+    {
+        fail();
+        return *this;
+    }
+    double v = (double)whole;
+    if (*_pos == '.')
+    {
+        _pos++;
+        unsigned long fraction;
+        int digits;
+        if (!readDigits(fraction, &digits))
+        {
+            fail();
+            return *this;
+        }
+        double scale = 1.0;
+        while (digits-- > 0)
+            scale *= 10.0;
+        v += (double)fraction / scale;
+    }
+    value = negative ? -v : v;
+    _count++;
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Parser &SparkFun_ublox_Cellular_Parser::quoted(char *dest, size_t size)
+{
+    if (!separator())
+        return *this;
+    if (*_pos != '\"')
+    {
+        fail();
+        return *this;
+    }
+    const char *end = strchr(_pos + 1, '\"');
+    if ((end == nullptr) || ((size_t)(end - _pos - 1) >= size))
+    {
+        fail();
+        return *this;
+    }
+    memcpy(dest, _pos + 1, end - _pos - 1);
+    dest[end - _pos - 1] = '\0';
+    _pos = end + 1;
+    _count++;
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Parser &SparkFun_ublox_Cellular_Parser::quoted(String &dest)
+{
+    if (!separator())
+        return *this;
+    if (*_pos != '\"')
+    {
+        fail();
+        return *this;
+    }
+    const char *end = strchr(_pos + 1, '\"');
+    if (end == nullptr)
+    {
+        fail();
+        return *this;
+    }
+    dest = "";
+    dest.reserve(end - _pos - 1);
+    for (const char *c = _pos + 1; c < end; c++)
+        dest.concat(*c);
+    _pos = end + 1;
+    _count++;
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Parser &SparkFun_ublox_Cellular_Parser::ipAddress(IPAddress &address)
+{
+    int octets[4];
+    int before = _count;
+    bool quote = false;
+    if (!separator())
+        return *this;
+    if (*_pos == '\"')
+    {
+        quote = true;
+        _pos++;
+    }
+    _first = true; // The separator has been read
+    dotted(octets, 4);
+    _count = before; // The address counts as one value
+    if (_failed)
+        return *this;
+    if (quote && (*_pos++ != '\"'))
+    {
+        fail();
+        return *this;
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        if ((octets[i] < 0) || (octets[i] > 255))
+        {
+            fail();
+            return *this;
+        }
+        address[i] = (uint8_t)octets[i];
+    }
+    _count++;
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Parser &SparkFun_ublox_Cellular_Parser::dotted(int *values, int count, char separator)
+{
+    for (int i = 0; (i < count) && !_failed; i++)
+    {
+        if (i > 0)
+            literal(separator);
+        integer(values[i]);
+    }
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Parser &SparkFun_ublox_Cellular_Parser::skip(void)
+{
+    if (!separator())
+        return *this;
+    if (*_pos == '\"')
+    {
+        const char *end = strchr(_pos + 1, '\"');
+        if (end == nullptr)
+        {
+            fail();
+            return *this;
+        }
+        _pos = end + 1;
+    }
+    else
+    {
+        while ((*_pos != ',') && (*_pos != '\0') && (*_pos != '\r') && (*_pos != '\n'))
+            _pos++;
+    }
+    return *this;
+}
+
+SparkFun_ublox_Cellular_Parser &SparkFun_ublox_Cellular_Parser::literal(char c)
+{
+    if (_failed)
+        return *this;
+    if (*_pos != c)
+    {
+        fail();
+        return *this;
+    }
+    _pos++;
+    _first = true;
+    return *this;
+}
+
+// Step over the comma before a field (and any spaces, as sscanf does). False if the parse has already failed
+bool SparkFun_ublox_Cellular_Parser::separator(void)
+{
+    if (_failed)
+        return false;
+    while (*_pos == ' ')
+        _pos++;
+    if (!_first)
+    {
+        if (*_pos != ',')
+            return fail();
+        _pos++;
+        while (*_pos == ' ')
+            _pos++;
+    }
+    _first = false;
+    return true;
+}
+
+bool SparkFun_ublox_Cellular_Parser::readInteger(long &value)
+{
+    if (!separator())
+        return false;
+    bool negative = (*_pos == '-');
+    if ((*_pos == '-') || (*_pos == '+'))
+        _pos++;
+    unsigned long v;
+    if (!readDigits(v))
+        return fail();
+    value = negative ? -(long)v : (long)v;
+    _count++;
+    return true;
+}
+
+bool SparkFun_ublox_Cellular_Parser::readHex(unsigned long &value)
+{
+    if (!separator())
+        return false;
+    bool quote = (*_pos == '\"');
+    if (quote)
+        _pos++;
+    unsigned long v = 0;
+    int digits = 0;
+    for (;; digits++, _pos++)
+    {
+        char c = *_pos;
+        if ((c >= '0') && (c <= '9'))
+            v = (v << 4) | (c - '0');
+        else if ((c >= 'A') && (c <= 'F'))
+            v = (v << 4) | (c - 'A' + 10);
+        else if ((c >= 'a') && (c <= 'f'))
+            v = (v << 4) | (c - 'a' + 10);
+        else
+            break;
+    }
+    if ((digits == 0) || (quote && (*_pos++ != '\"')))
+        return fail();
+    value = v;
+    _count++;
+    return true;
+}
+
+bool SparkFun_ublox_Cellular_Parser::readDigits(unsigned long &value, int *numDigits)
+{
+    unsigned long v = 0;
+    int digits = 0;
+    while ((*_pos >= '0') && (*_pos <= '9'))
+    {
+        v = (v * 10) + (*_pos++ - '0');
+        digits++;
+    }
+    if (numDigits != nullptr)
+        *numDigits = digits;
+    value = v;
+    return digits > 0;
+}
+
+bool SparkFun_ublox_Cellular_Parser::fail(void)
+{
+    _failed = true;
+    return false;
+}
@@ -0,0 +1,79 @@
+#ifndef SFE_UBLOX_CELLULAR_PARSER_H
+#define SFE_UBLOX_CELLULAR_PARSER_H
+
+#if (ARDUINO >= 100)
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include <IPAddress.h>
+#include <type_traits>
+
+// Reads the fields of a URC or response line in place, with a cursor, instead of sscanf. Each value is read with the
+// comma before it (the mirror of SparkFun_ublox_Cellular_Command), e.g.
+//   SparkFun_ublox_Cellular_Parser parser(event);
+//   parser.find(UBX_CELL_READ_SOCKET_URC).integer(socket).integer(length);
+// reads +UUSORD: 0,12. A literal other than a comma (e.g. the / and : in a date) replaces the comma before the next
+// value. Once a field does not match, the rest are skipped: count() says how many values were read, like the return
+// value of sscanf.
+class SparkFun_ublox_Cellular_Parser
+{
+  public:
+    SparkFun_ublox_Cellular_Parser(const char *text);
+
+    // Move to just after prefix (e.g. "+UUSORD:") and any spaces which follow it
+    SparkFun_ublox_Cellular_Parser &find(const char *prefix);
+
+    // Fields
+    template <typename T> SparkFun_ublox_Cellular_Parser &integer(T &value) // Decimal, with an optional sign
+    {
+        static_assert(std::is_integral<T>::value, "integer: use decimal for fractions");
+        long v;
+        if (readInteger(v))
+            value = (T)v;
+        return *this;
+    }
+    template <typename T> SparkFun_ublox_Cellular_Parser &hex(T &value) // Hexadecimal, optionally quoted
+    {
+        static_assert(std::is_integral<T>::value, "hex: needs an integer");
+        unsigned long v;
+        if (readHex(v))
+            value = (T)v;
+        return *this;
+    }
+    SparkFun_ublox_Cellular_Parser &decimal(double &value);                 // e.g. -12.3456789
+    SparkFun_ublox_Cellular_Parser &quoted(char *dest, size_t size);        // "text". Fails if it does not fit
+    SparkFun_ublox_Cellular_Parser &quoted(String &dest);                   // "text"
+    SparkFun_ublox_Cellular_Parser &ipAddress(IPAddress &address);          // a.b.c.d, optionally quoted
+    SparkFun_ublox_Cellular_Parser &dotted(int *values, int count, char separator = '.'); // Counts as count values
+    SparkFun_ublox_Cellular_Parser &skip(void);          // Step over a field, quoted or not, without reading it
+    SparkFun_ublox_Cellular_Parser &literal(char c);     // Expect c next. It takes the place of the comma
+
+    int count(void) // The number of values read
+    {
+        return _count;
+    }
+    bool ok(void) // Every field so far matched
+    {
+        return !_failed;
+    }
+    const char *position(void) // Where the next field starts, e.g. the quote before binary data
+    {
+        return _pos;
+    }
+
+  protected:
+    const char *_pos;
+    bool _first; // No comma before the next field
+    bool _failed;
+    int _count;
+
+    bool separator(void);
+    bool readInteger(long &value);
+    bool readHex(unsigned long &value);
+    bool readDigits(unsigned long &value, int *numDigits = nullptr);
+    bool fail(void);
+};
+
+#endif // SFE_UBLOX_CELLULAR_PARSER_H
@@ -0,0 +1,930 @@
+#include "sfe_ublox_cellular_simulator.h"
+
+#ifdef UBX_CELL_SIMULATOR_ENABLED
+
+#include "sfe_ublox_cellular_hex.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+// True if s starts with prefix, ignoring case. (The driver sends "at+urdblock" in lower case)
+static bool simStartsWith(const char *s, const char *prefix)
+{
+    return strncasecmp(s, prefix, strlen(prefix)) == 0;
+}
+
+// True if time a is at or after time b. Safe across micros() wrapping
+static bool simReached(unsigned long a, unsigned long b)
+{
+    return (long)(a - b) >= 0;
+}
+
+// Extract the quoted string which starts at (or after) s. Returns a pointer to the char after the closing quote,
+// or nullptr if there is no complete quoted string
+static const char *simQuoted(const char *s, std::string &out)
+{
+    const char *open = strchr(s, '\"');
+    if (open == nullptr)
+        return nullptr;
+    const char *close = strchr(open + 1, '\"');
+    if (close == nullptr)
+        return nullptr;
+    out.assign(open + 1, close - open - 1);
+    return close + 1;
+}
+
+SparkFun_ublox_Cellular_Simulator::SparkFun_ublox_Cellular_Simulator()
+{
+    _readIndex = 0;
+    _payloadRemaining = 0;
+    _payloadDone = nullptr;
+    _baud = 115200;
+    _moduleBaud = 115200;
+    _linkLimit = 0;
+    _linkErrorSeed = 1;
+    _throttle = false;
+    _writeBuffer = 0;
+    _latency = 0;
+    _urcDelay = 0;
+    _toHostFreeAt = 0;
+    _fromHostFreeAt = 0;
+    _echo = false;
+    _skipLF = false;
+    _hexMode = false;
+    _directLink = -1;
+    _guardTime = 1000000;
+    _lastFromHost = 0;
+    _escapeCount = 0;
+    _stormInterval = 0;
+    _stormRemaining = 0;
+    _stormNext = 0;
+    for (int i = 0; i < UBX_CELL_SIM_NUM_SOCKETS; i++)
+    {
+        _socketOpen[i] = false;
+        _socketProtocol[i] = 6;
+    }
+    _location = "16/10/2026,12:00:00.000,52.2053,0.1218,20,10,0,0,0,0,0,0,0,0";
+    _commandCount = 0;
+    _urcCount = 0;
+    _bytesIn = 0;
+    _bytesOut = 0;
+}
+
+void SparkFun_ublox_Cellular_Simulator::onCommand(const char *prefix, UBX_CELL_sim_handler_t handler)
+{
+    UBX_CELL_sim_command_t cmd;
+    cmd.prefix = prefix;
+    cmd.handler = handler;
+    _commands.push_back(cmd);
+}
+
+void SparkFun_ublox_Cellular_Simulator::setResponse(const char *prefix, const char *response)
+{
+    std::string text = response;
+    onCommand(prefix, [this, text](const char *command) {
+        (void)command;
+        reply(text.c_str(), text.length());
+        return true;
+    });
+}
+
+void SparkFun_ublox_Cellular_Simulator::setLatency(unsigned long latency)
+{
+    _latency = latency;
+}
+
+void SparkFun_ublox_Cellular_Simulator::setURCDelay(unsigned long delay)
+{
+    _urcDelay = delay;
+}
+
+void SparkFun_ublox_Cellular_Simulator::setThrottle(bool throttle)
+{
+    _throttle = throttle;
+}
+
+void SparkFun_ublox_Cellular_Simulator::setModuleBaud(unsigned long baud)
+{
+    _moduleBaud = baud;
+}
+
+void SparkFun_ublox_Cellular_Simulator::setLinkLimit(unsigned long baud)
+{
+    _linkLimit = baud;
+}
+
+void SparkFun_ublox_Cellular_Simulator::setWriteBuffer(size_t size)
+{
+    _writeBuffer = size;
+}
+
+void SparkFun_ublox_Cellular_Simulator::injectURC(const char *urc, unsigned long delay)
+{
+    queueURC(urc, delay);
+}
+
+void SparkFun_ublox_Cellular_Simulator::startURCStorm(const char *urc, unsigned long interval, unsigned long count)
+{
+    _stormURC = urc;
+    _stormInterval = interval;
+    _stormRemaining = count;
+    _stormNext = micros();
+}
+
+void SparkFun_ublox_Cellular_Simulator::injectSocketData(int socket, const char *data, size_t len)
+{
+    if ((socket < 0) || (socket >= UBX_CELL_SIM_NUM_SOCKETS))
+        return;
+
+    if (socket == _directLink)
+    {
+        queue(std::string(data, len), 0);
+        return;
+    }
+
+    _socketRx[socket].append(data, len);
+
+    char urc[32];
+    snprintf(urc, sizeof(urc), "%s: %d,%d", (_socketProtocol[socket] == 17) ? "+UUSORF" : "+UUSORD", socket,
+             (int)_socketRx[socket].length());
+    queueURC(urc, 0);
+}
+
+void SparkFun_ublox_Cellular_Simulator::remoteClose(int socket)
+{
+    if ((socket < 0) || (socket >= UBX_CELL_SIM_NUM_SOCKETS))
+        return;
+
+    _socketOpen[socket] = false;
+    if (socket == _directLink)
+    {
+        _directLink = -1;
+        _escapeCount = 0;
+        queue("\r\nNO CARRIER\r\n", 0);
+    }
+    else
+    {
+        char urc[32];
+        snprintf(urc, sizeof(urc), "+UUSOCL: %d", socket);
+        queueURC(urc, 0);
+    }
+}
+
+void SparkFun_ublox_Cellular_Simulator::setGuardTime(unsigned long guardTime)
+{
+    _guardTime = guardTime;
+}
+
+void SparkFun_ublox_Cellular_Simulator::setFile(const char *name, const char *data, size_t len)
+{
+    UBX_CELL_sim_file_t *f = findFile(name);
+    if (f == nullptr)
+    {
+        UBX_CELL_sim_file_t newFile;
+        newFile.name = name;
+        _files.push_back(newFile);
+        f = &_files.back();
+    }
+    f->data.assign(data, len);
+}
+
+void SparkFun_ublox_Cellular_Simulator::setLocation(const char *location)
+{
+    _location = location;
+}
+
+void SparkFun_ublox_Cellular_Simulator::reply(const char *text)
+{
+    queue(std::string(text), _latency);
+}
+
+void SparkFun_ublox_Cellular_Simulator::reply(const char *data, size_t len)
+{
+    queue(std::string(data, len), _latency);
+}
+
+void SparkFun_ublox_Cellular_Simulator::ok(void)
+{
+    reply("\r\nOK\r\n");
+}
+
+void SparkFun_ublox_Cellular_Simulator::error(void)
+{
+    reply("\r\nERROR\r\n");
+}
+
+void SparkFun_ublox_Cellular_Simulator::cmeError(int code)
+{
+    char text[32];
+    snprintf(text, sizeof(text), "\r\n+CME ERROR: %d\r\n", code);
+    reply(text);
+}
+
+void SparkFun_ublox_Cellular_Simulator::expectPayload(const char *prompt, size_t len,
+                                                      std::function<void(const std::string &payload)> done)
+{
+    reply(prompt);
+    _payload.clear();
+    if (len == 0)
+    {
+        done(_payload);
+        return;
+    }
+    _payloadRemaining = len;
+    _payloadDone = done;
+}
+
+const std::string &SparkFun_ublox_Cellular_Simulator::socketWritten(int socket)
+{
+    static const std::string none;
+    if ((socket < 0) || (socket >= UBX_CELL_SIM_NUM_SOCKETS))
+        return none;
+    return _socketTx[socket];
+}
+
+const std::string &SparkFun_ublox_Cellular_Simulator::file(const char *name)
+{
+    static const std::string none;
+    UBX_CELL_sim_file_t *f = findFile(name);
+    if (f == nullptr)
+        return none;
+    return f->data;
+}
+
+void SparkFun_ublox_Cellular_Simulator::service(SparkFun_ublox_Cellular_Transport &link)
+{
+    char buf[256];
+    size_t n;
+
+    while ((n = link.read(buf, sizeof(buf))) > 0)
+        write(buf, n);
+
+    while ((n = read(buf, sizeof(buf))) > 0)
+        link.write(buf, n);
+}
+
+void SparkFun_ublox_Cellular_Simulator::begin(unsigned long baud)
+{
+    _baud = baud;
+}
+
+void SparkFun_ublox_Cellular_Simulator::end(void)
+{
+    // Nothing to do. The simulated module keeps its state across baud rate changes
+}
+
+int SparkFun_ublox_Cellular_Simulator::available(void)
+{
+    pump();
+    return (int)(_readable.length() - _readIndex);
+}
+
+size_t SparkFun_ublox_Cellular_Simulator::read(char *dest, size_t len)
+{
+    pump();
+
+    size_t avail = _readable.length() - _readIndex;
+    if (len > avail)
+        len = avail;
+    memcpy(dest, _readable.data() + _readIndex, len);
+    _readIndex += len;
+    _bytesOut += len;
+
+    if (_readIndex == _readable.length())
+    {
+        _readable.clear();
+        _readIndex = 0;
+    }
+
+    return len;
+}
+
+size_t SparkFun_ublox_Cellular_Simulator::write(const char *src, size_t len)
+{
+    if (len == 0)
+        return 0;
+
+    unsigned long now = micros();
+    UBX_CELL_sim_chunk_t chunk;
+    chunk.readyAt = simReached(now, _fromHostFreeAt) ? now : _fromHostFreeAt;
+    chunk.data.assign(src, len);
+    garble(chunk.data);
+    _fromHostFreeAt = chunk.readyAt + (len * byteTime());
+    _fromHost.push_back(chunk);
+    _bytesIn += len;
+
+    pump();
+    return len;
+}
+
+size_t SparkFun_ublox_Cellular_Simulator::writev(const UBX_CELL_iovec_t *iov, int count)
+{
+    std::string gathered;
+    for (int i = 0; i < count; i++)
+        gathered.append(iov[i].data, iov[i].len);
+    return write(gathered.data(), gathered.length());
+}
+
+size_t SparkFun_ublox_Cellular_Simulator::tryWrite(const char *src, size_t len)
+{
+    if (_writeBuffer > 0)
+    {
+        pump();
+        size_t inFlight = 0;
+        for (size_t i = 0; i < _fromHost.size(); i++)
+            inFlight += _fromHost[i].data.length();
+        size_t room = (inFlight < _writeBuffer) ? (_writeBuffer - inFlight) : 0;
+        if (len > room)
+            len = room;
+    }
+    return write(src, len);
+}
+
+// Corrupt data if the baud rates do not match (every byte) or the link is being driven too fast (some bytes)
+void SparkFun_ublox_Cellular_Simulator::garble(std::string &data)
+{
+    if (_baud != _moduleBaud)
+    {
+        for (size_t i = 0; i < data.length(); i++)
+            data[i] = data[i] ^ 0x5A;
+    }
+    else if ((_linkLimit > 0) && (_moduleBaud > _linkLimit))
+    {
+        for (size_t i = 0; i < data.length(); i++)
+        {
+            _linkErrorSeed = (_linkErrorSeed * 1103515245UL) + 12345UL; // Repeatable pseudo-random errors
+            if (((_linkErrorSeed >> 16) % UBX_CELL_SIM_LINK_ERROR_RATE) == 0)
+                data[i] = data[i] ^ 0x5A;
+        }
+    }
+}
+
+unsigned long SparkFun_ublox_Cellular_Simulator::byteTime(void)
+{
+    if ((!_throttle) || (_baud == 0))
+        return 0;
+    return (10000000UL + _baud - 1) / _baud; // Start bit, 8 data bits, stop bit
+}
+
+void SparkFun_ublox_Cellular_Simulator::pump(void)
+{
+    unsigned long now = micros();
+    unsigned long bt = byteTime();
+
+    // URC storm
+    while ((_stormRemaining > 0) && simReached(now, _stormNext))
+    {
+        queueURC(_stormURC, 0);
+        _stormNext += _stormInterval;
+        _stormRemaining--;
+    }
+
+    // Bytes from the host which have arrived
+    while (!_fromHost.empty())
+    {
+        UBX_CELL_sim_chunk_t &chunk = _fromHost.front();
+        size_t n = chunk.data.length();
+        if (bt > 0)
+        {
+            if (!simReached(now, chunk.readyAt))
+                break;
+            size_t arrived = (now - chunk.readyAt) / bt;
+            if (arrived < n)
+                n = arrived;
+            if (n == 0)
+                break;
+        }
+        std::string bytes = chunk.data.substr(0, n);
+        bool partial = (n < chunk.data.length());
+        if (partial)
+        {
+            chunk.data.erase(0, n);
+            chunk.readyAt += n * bt;
+        }
+        else
+        {
+            _fromHost.pop_front();
+        }
+        for (size_t i = 0; i < bytes.length(); i++)
+            receive(bytes[i]);
+        if (partial)
+            break;
+    }
+
+    // A +++ escape followed by the guard time ends Direct Link mode
+    if ((_escapeCount == 3) && ((now - _lastFromHost) >= _guardTime))
+    {
+        _escapeCount = 0;
+        _directLink = -1;
+        queue("\r\nDISCONNECT\r\n", _latency);
+    }
+
+    // Bytes to the host which have arrived
+    while (!_toHost.empty())
+    {
+        UBX_CELL_sim_chunk_t &chunk = _toHost.front();
+        if (!simReached(now, chunk.readyAt))
+            break;
+        size_t n = chunk.data.length();
+        if (bt > 0)
+        {
+            unsigned long start = simReached(chunk.readyAt, _toHostFreeAt) ? chunk.readyAt : _toHostFreeAt;
+            if (!simReached(now, start))
+                break;
+            size_t arrived = (now - start) / bt;
+            if (arrived < n)
+                n = arrived;
+            if (n == 0)
+                break;
+            _toHostFreeAt = start + (n * bt);
+        }
+        _readable.append(chunk.data, 0, n);
+        if (n == chunk.data.length())
+        {
+            _toHost.pop_front();
+        }
+        else
+        {
+            chunk.data.erase(0, n);
+            chunk.readyAt = _toHostFreeAt;
+            break;
+        }
+    }
+}
+
+void SparkFun_ublox_Cellular_Simulator::receive(char c)
+{
+    if (_skipLF)
+    {
+        _skipLF = false;
+        if (c == '\n')
+            return;
+    }
+
+    if (_directLink >= 0)
+    {
+        directLinkReceive(c);
+        return;
+    }
+
+    if (_payloadRemaining > 0)
+    {
+        _payload += c;
+        if (--_payloadRemaining == 0)
+        {
+            std::function<void(const std::string &payload)> done = _payloadDone;
+            _payloadDone = nullptr;
+            std::string payload;
+            payload.swap(_payload);
+            done(payload);
+        }
+        return;
+    }
+
+    if (c == '\r')
+    {
+        std::string line;
+        line.swap(_line);
+        _skipLF = true;
+        if (_echo)
+            queue(line + "\r", 0);
+        processCommand(line);
+    }
+    else if (c != '\n')
+    {
+        _line += c;
+    }
+}
+
+void SparkFun_ublox_Cellular_Simulator::directLinkReceive(char c)
+{
+    unsigned long now = micros();
+
+    // A + after the guard time might start an escape. Hold the +'s back until we know
+    if ((c == '+') && (_escapeCount < 3) && ((_escapeCount > 0) || ((now - _lastFromHost) >= _guardTime)))
+    {
+        _escapeCount++;
+    }
+    else
+    {
+        _socketTx[_directLink].append(_escapeCount, '+');
+        _escapeCount = 0;
+        _socketTx[_directLink] += c;
+    }
+    _lastFromHost = now;
+}
+
+void SparkFun_ublox_Cellular_Simulator::queue(const std::string &data, unsigned long delay)
+{
+    UBX_CELL_sim_chunk_t chunk;
+    chunk.readyAt = micros() + delay;
+    chunk.data = data;
+    garble(chunk.data); // At the module's rate at the time
+
+    // Keep the queue in readyAt order. Chunks which are ready at the same time stay in the order they were queued
+    std::deque<UBX_CELL_sim_chunk_t>::iterator it = _toHost.end();
+    while ((it != _toHost.begin()) && !simReached(chunk.readyAt, (it - 1)->readyAt))
+        it--;
+    _toHost.insert(it, chunk);
+}
+
+void SparkFun_ublox_Cellular_Simulator::queueURC(const std::string &urc, unsigned long delay)
+{
+    _urcCount++;
+    queue("\r\n" + urc + "\r\n", delay);
+}
+
+void SparkFun_ublox_Cellular_Simulator::processCommand(const std::string &line)
+{
+    const char *command = line.c_str();
+    while (*command == ' ')
+        command++;
+    if (!simStartsWith(command, "AT"))
+        return; // The module ignores anything which is not a command
+    command += 2;
+
+    _commandCount++;
+    _lastCommand = command;
+
+    for (size_t i = 0; i < _commands.size(); i++)
+    {
+        if (simStartsWith(command, _commands[i].prefix.c_str()) && _commands[i].handler(command))
+            return;
+    }
+
+    if (!builtInCommand(command))
+        ok();
+}
+
+SparkFun_ublox_Cellular_Simulator::UBX_CELL_sim_file_t *SparkFun_ublox_Cellular_Simulator::findFile(
+    const std::string &name)
+{
+    for (size_t i = 0; i < _files.size(); i++)
+    {
+        if (_files[i].name == name)
+            return &_files[i];
+    }
+    return nullptr;
+}
+
+bool SparkFun_ublox_Cellular_Simulator::parseSocket(const char *args, int *socket)
+{
+    if (sscanf(args, "%d", socket) != 1)
+        return false;
+    return (*socket >= 0) && (*socket < UBX_CELL_SIM_NUM_SOCKETS) && _socketOpen[*socket];
+}
+
+bool SparkFun_ublox_Cellular_Simulator::builtInCommand(const char *command)
+{
+    char text[96];
+    int socket;
+    int len;
+
+    if ((simStartsWith(command, "E0")) || (simStartsWith(command, "E1")))
+    {
+        _echo = (command[1] == '1');
+        ok();
+    }
+    else if (simStartsWith(command, "+CGMI"))
+    {
+        reply("\r\nu-blox\r\n");
+        ok();
+    }
+    else if (simStartsWith(command, "+CGMM"))
+    {
+        reply("\r\nLARA-R6001D\r\n");
+        ok();
+    }
+    else if (simStartsWith(command, "+CGMR"))
+    {
+        reply("\r\n03.15\r\n");
+        ok();
+    }
+    else if ((simStartsWith(command, "+CGSN")) || (simStartsWith(command, "+GSN")))
+    {
+        reply("\r\n351234567890123\r\n");
+        ok();
+    }
+    else if (simStartsWith(command, "+CIMI"))
+    {
+        reply("\r\n001010123456789\r\n");
+        ok();
+    }
+    else if (simStartsWith(command, "+CCID"))
+    {
+        reply("\r\n+CCID: 8901260123456789012\r\n");
+        ok();
+    }
+    else if (simStartsWith(command, "+CSQ"))
+    {
+        reply("\r\n+CSQ: 20,99\r\n");
+        ok();
+    }
+    else if (simStartsWith(command, "+CREG?"))
+    {
+        reply("\r\n+CREG: 0,1\r\n");
+        ok();
+    }
+    else if (simStartsWith(command, "+CEREG?"))
+    {
+        reply("\r\n+CEREG: 0,1\r\n");
+        ok();
+    }
+    else if (simStartsWith(command, "+COPS?"))
+    {
+        reply("\r\n+COPS: 0,0,\"Simulator\",7\r\n");
+        ok();
+    }
+    else if (simStartsWith(command, "+UGPS?"))
+    {
+        reply("\r\n+UGPS: 0\r\n");
+        ok();
+    }
+    else if (simStartsWith(command, "+IPR?"))
+    {
+        snprintf(text, sizeof(text), "\r\n+IPR: %lu\r\n", _moduleBaud);
+        reply(text);
+        ok();
+    }
+    else if (simStartsWith(command, "+IPR="))
+    {
+        static const unsigned long rates[] = {9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600};
+        unsigned long baud = strtoul(command + 5, nullptr, 10);
+        for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++)
+        {
+            if (rates[i] == baud)
+            {
+                ok(); // At the old rate
+                _moduleBaud = baud;
+                return true;
+            }
+        }
+        error();
+    }
+    else if (simStartsWith(command, "+USOCR="))
+    {
+        int protocol = atoi(command + 7);
+        for (socket = 0; socket < UBX_CELL_SIM_NUM_SOCKETS; socket++)
+        {
+            if (!_socketOpen[socket])
+                break;
+        }
+        if (socket == UBX_CELL_SIM_NUM_SOCKETS)
+        {
+            error();
+            return true;
+        }
+        _socketOpen[socket] = true;
+        _socketProtocol[socket] = protocol;
+        _socketRx[socket].clear();
+        _socketTx[socket].clear();
+        snprintf(text, sizeof(text), "\r\n+USOCR: %d\r\n", socket);
+        reply(text);
+        ok();
+    }
+    else if (simStartsWith(command, "+USOCO="))
+    {
+        if (parseSocket(command + 7, &socket))
+            ok();
+        else
+            error();
+    }
+    else if (simStartsWith(command, "+USOCL="))
+    {
+        if (!parseSocket(command + 7, &socket))
+        {
+            error();
+            return true;
+        }
+        _socketOpen[socket] = false;
+        ok();
+        if (strchr(command, ',') != nullptr) // Asynchronous close
+        {
+            snprintf(text, sizeof(text), "+UUSOCL: %d", socket);
+            queueURC(text, _latency + _urcDelay);
+        }
+    }
+    else if (simStartsWith(command, "+USODL="))
+    {
+        if ((!parseSocket(command + 7, &socket)) || (_socketProtocol[socket] != 6))
+        {
+            error();
+            return true;
+        }
+        reply("\r\nCONNECT\r\n");
+        _directLink = socket;
+        _escapeCount = 0;
+        _lastFromHost = micros();
+        if (_socketRx[socket].length() > 0) // Anything already received follows CONNECT
+        {
+            reply(_socketRx[socket].data(), _socketRx[socket].length());
+            _socketRx[socket].clear();
+        }
+    }
+    else if ((simStartsWith(command, "+USOWR=")) || (simStartsWith(command, "+USOST=")))
+    {
+        bool udp = simStartsWith(command, "+USOST=");
+        const char *lenPtr = strrchr(command, ',');
+        if ((!parseSocket(command + 7, &socket)) || (lenPtr == nullptr))
+        {
+            error();
+            return true;
+        }
+        std::string data;
+        if (simQuoted(lenPtr, data) != nullptr) // String mode: +USOWR=s,len,"data"
+        {
+            lenPtr = command + 7;
+            for (int i = 0; i < (udp ? 3 : 1); i++)
+                lenPtr = strchr(lenPtr, ',') + 1;
+            len = atoi(lenPtr);
+            if (_hexMode)
+            {
+                std::string bytes(data.length() / 2, '\0');
+                if ((data.length() != 2 * (size_t)len) ||
+                    (!SparkFun_ublox_Cellular_Hex::decode(data.data(), bytes.length(), &bytes[0])))
+                {
+                    error();
+                    return true;
+                }
+                data = bytes;
+            }
+            _socketTx[socket].append(data);
+            snprintf(text, sizeof(text), "\r\n%s: %d,%d\r\n", udp ? "+USOST" : "+USOWR", socket, len);
+            reply(text);
+            ok();
+            return true;
+        }
+        len = atoi(lenPtr + 1);
+        expectPayload("\r\n@", (size_t)len, [this, socket, udp](const std::string &payload) {
+            char result[32];
+            _socketTx[socket].append(payload);
+            snprintf(result, sizeof(result), "\r\n%s: %d,%d\r\n", udp ? "+USOST" : "+USOWR", socket,
+                     (int)payload.length());
+            reply(result);
+            ok();
+        });
+    }
+    else if ((simStartsWith(command, "+USORD=")) || (simStartsWith(command, "+USORF=")))
+    {
+        bool udp = simStartsWith(command, "+USORF=");
+        const char *lenPtr = strchr(command, ',');
+        if ((!parseSocket(command + 7, &socket)) || (lenPtr == nullptr))
+        {
+            error();
+            return true;
+        }
+        size_t want = (size_t)atoi(lenPtr + 1);
+        std::string &rx = _socketRx[socket];
+        if (want == 0) // How much is available?
+        {
+            snprintf(text, sizeof(text), "\r\n%s: %d,%d\r\n", udp ? "+USORF" : "+USORD", socket, (int)rx.length());
+            reply(text);
+            ok();
+            return true;
+        }
+        if (want > rx.length())
+            want = rx.length();
+        if (udp)
+            snprintf(text, sizeof(text), "\r\n+USORF: %d,\"192.168.0.1\",1234,%d,\"", socket, (int)want);
+        else
+            snprintf(text, sizeof(text), "\r\n+USORD: %d,%d,\"", socket, (int)want);
+        std::string response = text;
+        if (_hexMode)
+        {
+            std::string digits(2 * want, '\0');
+            SparkFun_ublox_Cellular_Hex::encode(rx.data(), want, &digits[0]);
+            response += digits;
+        }
+        else
+        {
+            response.append(rx, 0, want);
+        }
+        response += "\"\r\n";
+        rx.erase(0, want);
+        reply(response.data(), response.length());
+        ok();
+    }
+    else if (simStartsWith(command, "+UDCONF=1,"))
+    {
+        _hexMode = (atoi(command + 10) == 1);
+        ok();
+    }
+    else if (simStartsWith(command, "+UHTTPC="))
+    {
+        int profile = 0;
+        int httpCommand = 0;
+        sscanf(command + 8, "%d,%d", &profile, &httpCommand);
+        ok();
+        snprintf(text, sizeof(text), "+UUHTTPCR: %d,%d,1", profile, httpCommand);
+        queueURC(text, _latency + _urcDelay);
+    }
+    else if (simStartsWith(command, "+UMQTTC="))
+    {
+        int mqttCommand = atoi(command + 8);
+        snprintf(text, sizeof(text), "\r\n+UMQTTC: %d,1\r\n", mqttCommand);
+        reply(text);
+        ok();
+        snprintf(text, sizeof(text), "+UUMQTTC: %d,1", mqttCommand);
+        queueURC(text, _latency + _urcDelay);
+    }
+    else if (simStartsWith(command, "+ULOC=2"))
+    {
+        ok();
+        queueURC("+UULOC: " + _location, _latency + _urcDelay);
+    }
+    else if (simStartsWith(command, "+ULSTFILE=2,"))
+    {
+        std::string name;
+        UBX_CELL_sim_file_t *f = nullptr;
+        if (simQuoted(command, name) != nullptr)
+            f = findFile(name);
+        if (f == nullptr)
+        {
+            error();
+            return true;
+        }
+        snprintf(text, sizeof(text), "\r\n+ULSTFILE: %d\r\n", (int)f->data.length());
+        reply(text);
+        ok();
+    }
+    else if (simStartsWith(command, "+URDFILE="))
+    {
+        std::string name;
+        UBX_CELL_sim_file_t *f = nullptr;
+        if (simQuoted(command, name) != nullptr)
+            f = findFile(name);
+        if (f == nullptr)
+        {
+            error();
+            return true;
+        }
+        snprintf(text, sizeof(text), "\",%d,\"", (int)f->data.length());
+        std::string response = "\r\n+URDFILE: \"" + name + text + f->data + "\"\r\n";
+        reply(response.data(), response.length());
+        ok();
+    }
+    else if (simStartsWith(command, "+URDBLOCK="))
+    {
+        std::string name;
+        int offset = 0;
+        UBX_CELL_sim_file_t *f = nullptr;
+        const char *args = simQuoted(command, name);
+        if (args != nullptr)
+            f = findFile(name);
+        if ((f == nullptr) || (sscanf(args, ",%d,%d", &offset, &len) != 2) || (offset < 0) ||
+            ((size_t)offset > f->data.length()))
+        {
+            error();
+            return true;
+        }
+        std::string block = f->data.substr(offset, len);
+        snprintf(text, sizeof(text), "\",%d,\"", (int)block.length());
+        std::string response = "\r\n+URDBLOCK: \"" + name + text + block + "\"\r\n";
+        reply(response.data(), response.length());
+        ok();
+    }
+    else if (simStartsWith(command, "+UDWNFILE="))
+    {
+        std::string name;
+        const char *args = simQuoted(command, name);
+        if ((args == nullptr) || (sscanf(args, ",%d", &len) != 1))
+        {
+            error();
+            return true;
+        }
+        expectPayload("\r\n>", (size_t)len, [this, name](const std::string &payload) {
+            UBX_CELL_sim_file_t *f = findFile(name);
+            if (f == nullptr)
+                setFile(name.c_str(), payload.data(), payload.length());
+            else
+                f->data.append(payload);
+            ok();
+        });
+    }
+    else if (simStartsWith(command, "+UDELFILE="))
+    {
+        std::string name;
+        if (simQuoted(command, name) != nullptr)
+        {
+            for (size_t i = 0; i < _files.size(); i++)
+            {
+                if (_files[i].name == name)
+                {
+                    _files.erase(_files.begin() + i);
+                    break;
+                }
+            }
+        }
+        ok();
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+#endif // UBX_CELL_SIMULATOR_ENABLED
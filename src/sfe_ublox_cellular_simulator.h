@@ -0,0 +1,204 @@
+#ifndef SFE_UBLOX_CELLULAR_SIMULATOR_H
+#define SFE_UBLOX_CELLULAR_SIMULATOR_H
+
+#include "sfe_ublox_cellular_transport.h"
+
+#if defined(__unix__) || defined(__APPLE__) // Linux, macOS, BSD... host builds
+#define UBX_CELL_SIMULATOR_ENABLED          // Enable the simulator
+#endif
+
+#ifdef UBX_CELL_SIMULATOR_ENABLED
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#define UBX_CELL_SIM_NUM_SOCKETS 7
+#define UBX_CELL_SIM_LINK_ERROR_RATE 16
+
+// Handler for a simulated AT command. command is the text after "AT", e.g. "+USORD=0,5".
+// Return true if the command was handled (the handler queues the response with reply/ok/error etc.),
+// false to pass it on to the next handler and finally the built-in dialect
+typedef std::function<bool(const char *command)> UBX_CELL_sim_handler_t;
+
+// Scriptable stand-in for a u-blox module, for host-side testing and benchmarking.
+// It is a transport: pass it to SparkFun_ublox_Cellular::begin and the driver talks to it directly, at full speed.
+// Or call service() in a loop to run it on the far end of another transport, such as a POSIX pty or socketpair.
+//
+// The built-in dialect covers the commands the driver uses most: identification, +CSQ, +CREG/+CEREG, +COPS,
+// the socket commands (+USOCR, +USOCO, +USOWR, +USOST, +USORD, +USORF, +USOCL and the +UUSORD/+UUSOCL URCs),
+// socket hex mode (+UDCONF=1),
+// Direct Link mode (+USODL, the +++ escape and NO CARRIER),
+// +IPR, +UHTTPC, +UMQTTC, the file system (+ULSTFILE, +URDFILE, +URDBLOCK, +UDWNFILE, +UDELFILE) and +ULOC/+UULOC.
+// Anything else gets OK. Use onCommand or setResponse to change or extend it.
+class SparkFun_ublox_Cellular_Simulator : public SparkFun_ublox_Cellular_Transport
+{
+  public:
+    SparkFun_ublox_Cellular_Simulator();
+
+    // Scripting
+
+    // Handle commands which start with prefix (e.g. "+CSQ"). Checked in the order added, before the built-in dialect
+    void onCommand(const char *prefix, UBX_CELL_sim_handler_t handler);
+    // Reply to commands which start with prefix with exactly this text, e.g. "\r\n+CSQ: 5,99\r\n\r\nOK\r\n"
+    void setResponse(const char *prefix, const char *response);
+    // Microseconds between the end of a command and the start of its response. Default 0
+    void setLatency(unsigned long latency);
+    // Microseconds between a command and any URC which reports its result (+UUHTTPCR, +UUMQTTC, +UULOC...). Default 0
+    void setURCDelay(unsigned long delay);
+    // Move bytes no faster than the baud rate passed to begin would allow, in both directions. Default false
+    void setThrottle(bool throttle);
+    // The module's own baud rate, as set by +IPR. Bytes are garbled in both directions when it differs from the rate
+    // passed to begin. Default 115200
+    void setModuleBaud(unsigned long baud);
+    // Garble (on average) one byte in UBX_CELL_SIM_LINK_ERROR_RATE while the module's baud rate is above this, like a cable or level
+    // shifter which cannot keep up. Default 0: no limit
+    void setLinkLimit(unsigned long baud);
+    // Limit tryWrite to this many bytes in flight from the host, like a UART FIFO behind RTS/CTS. Default 0: no limit
+    void setWriteBuffer(size_t size);
+
+    // Queue an unsolicited line, e.g. "+UUSOCL: 0". \r\n framing is added
+    void injectURC(const char *urc, unsigned long delay = 0);
+    // Send urc every interval microseconds, count times, interleaved with everything else
+    void startURCStorm(const char *urc, unsigned long interval, unsigned long count);
+    // Make data available on a socket and announce it with +UUSORD (TCP) or +UUSORF (UDP).
+    // In Direct Link mode the data is sent straight to the host instead
+    void injectSocketData(int socket, const char *data, size_t len);
+    // The remote end closes a socket: +UUSOCL, or NO CARRIER in Direct Link mode
+    void remoteClose(int socket);
+    // Microseconds of silence needed either side of the +++ Direct Link escape. Default 1000000 (ATS12=50)
+    void setGuardTime(unsigned long guardTime);
+    // Create or replace a file in the simulated file system
+    void setFile(const char *name, const char *data, size_t len);
+    // The fields +UULOC reports after +ULOC, e.g. "16/10/2026,12:00:00.000,52.2053,0.1218,20,10,0,0,0,0,0,0,0,0"
+    void setLocation(const char *location);
+
+    // Building blocks for command handlers
+    void reply(const char *text);             // Queue text exactly as given
+    void reply(const char *data, size_t len); // Queue binary data exactly as given
+    void ok(void);                            // Queue "\r\nOK\r\n"
+    void error(void);                         // Queue "\r\nERROR\r\n"
+    void cmeError(int code);                  // Queue "\r\n+CME ERROR: <code>\r\n"
+    // Queue prompt, then collect the next len bytes written as a payload and pass them to done
+    void expectPayload(const char *prompt, size_t len, std::function<void(const std::string &payload)> done);
+
+    // Inspection
+    const std::string &socketWritten(int socket); // Everything written to a socket with +USOWR / +USOST
+    const std::string &file(const char *name);    // Contents of a file, e.g. after appendFileContents
+    const std::string &lastCommand(void)
+    {
+        return _lastCommand;
+    }
+    unsigned long commandCount(void)
+    {
+        return _commandCount;
+    }
+    unsigned long urcCount(void)
+    {
+        return _urcCount;
+    }
+    size_t bytesIn(void)
+    {
+        return _bytesIn;
+    }
+    size_t bytesOut(void)
+    {
+        return _bytesOut;
+    }
+
+    // Run the simulator on the far end of another transport: move any bytes in both directions, then return
+    void service(SparkFun_ublox_Cellular_Transport &link);
+
+    // Transport
+    void begin(unsigned long baud) override;
+    void end(void) override;
+    int available(void) override;
+    size_t read(char *dest, size_t len) override;
+    size_t write(const char *src, size_t len) override;
+    size_t writev(const UBX_CELL_iovec_t *iov, int count) override; // Arrives as one chunk, like a real gather write
+    size_t tryWrite(const char *src, size_t len) override;          // Honours setWriteBuffer
+
+  protected:
+    typedef struct
+    {
+        unsigned long readyAt; // micros() when the first byte may be delivered
+        std::string data;
+    } UBX_CELL_sim_chunk_t;
+
+    typedef struct
+    {
+        std::string prefix;
+        UBX_CELL_sim_handler_t handler;
+    } UBX_CELL_sim_command_t;
+
+    typedef struct
+    {
+        std::string name;
+        std::string data;
+    } UBX_CELL_sim_file_t;
+
+    std::vector<UBX_CELL_sim_command_t> _commands;
+    std::deque<UBX_CELL_sim_chunk_t> _toHost;   // Queued output, in readyAt order
+    std::deque<UBX_CELL_sim_chunk_t> _fromHost; // Written by the host, not yet 'arrived' (throttling)
+    std::string _readable;                      // Output which has arrived and can be read
+    size_t _readIndex;
+    std::string _line; // Command being received
+    std::string _lastCommand;
+
+    size_t _payloadRemaining; // Non-zero while collecting a payload after a prompt
+    std::string _payload;
+    std::function<void(const std::string &payload)> _payloadDone;
+
+    unsigned long _baud;       // The host's rate, from begin
+    unsigned long _moduleBaud; // The simulated module's rate
+    unsigned long _linkLimit;
+    unsigned long _linkErrorSeed; // Decides which bytes carried above _linkLimit are garbled
+    bool _throttle;
+    size_t _writeBuffer;
+    unsigned long _latency;
+    unsigned long _urcDelay;
+    unsigned long _toHostFreeAt;   // micros() when the simulated line to the host is next idle
+    unsigned long _fromHostFreeAt; // micros() when the simulated line from the host is next idle
+    bool _echo;
+    bool _skipLF; // Swallow the \n of a \r\n command terminator, so it does not become part of a payload
+
+    bool _hexMode;                // +UDCONF=1,1: socket data is read and written as hex
+    int _directLink;              // Socket in Direct Link mode, or -1
+    unsigned long _guardTime;     // Microseconds either side of +++
+    unsigned long _lastFromHost;  // micros() when the last byte arrived from the host
+    int _escapeCount;             // +'s of a possible escape sequence, held back from the socket
+
+    std::string _stormURC;
+    unsigned long _stormInterval;
+    unsigned long _stormRemaining;
+    unsigned long _stormNext;
+
+    bool _socketOpen[UBX_CELL_SIM_NUM_SOCKETS];
+    int _socketProtocol[UBX_CELL_SIM_NUM_SOCKETS];
+    std::string _socketRx[UBX_CELL_SIM_NUM_SOCKETS];
+    std::string _socketTx[UBX_CELL_SIM_NUM_SOCKETS];
+    std::vector<UBX_CELL_sim_file_t> _files;
+    std::string _location;
+
+    unsigned long _commandCount;
+    unsigned long _urcCount;
+    size_t _bytesIn;
+    size_t _bytesOut;
+
+    unsigned long byteTime(void); // Microseconds per byte when throttled, else 0
+    void garble(std::string &data);
+    void pump(void);              // Advance the simulation to micros()
+    void receive(char c);
+    void directLinkReceive(char c);
+    void queue(const std::string &data, unsigned long delay);
+    void queueURC(const std::string &urc, unsigned long delay);
+    void processCommand(const std::string &line);
+    bool builtInCommand(const char *command);
+    UBX_CELL_sim_file_t *findFile(const std::string &name);
+    bool parseSocket(const char *args, int *socket);
+};
+
+#endif // UBX_CELL_SIMULATOR_ENABLED
+
+#endif // SFE_UBLOX_CELLULAR_SIMULATOR_H
@@ -0,0 +1,68 @@
+#ifndef SFE_UBLOX_CELLULAR_TRANSPORT_H
+#define SFE_UBLOX_CELLULAR_TRANSPORT_H
+
+#if (ARDUINO >= 100)
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+// One segment of a scatter-gather write
+typedef struct
+{
+    const char *data;
+    size_t len;
+} UBX_CELL_iovec_t;
+
+// Abstract link between the driver and the module.
+// Pass one of these to SparkFun_ublox_Cellular::begin instead of a HardwareSerial or SoftwareSerial to run the driver
+// over something other than an Arduino serial port: a Linux tty, a pty, a socket, a simulator...
+class SparkFun_ublox_Cellular_Transport
+{
+  public:
+    virtual ~SparkFun_ublox_Cellular_Transport()
+    {
+    }
+
+    // (Re)start the link at the given baud rate. Called by the driver each time it changes baud rate.
+    // Transports which have no baud rate (sockets, simulators) can ignore it.
+    virtual void begin(unsigned long baud) = 0;
+
+    // Stop the link. Called by the driver before it changes baud rate. This should not close the underlying device.
+    virtual void end(void) = 0;
+
+    // Return the number of bytes which can be read without waiting, or -1 if the link is not open
+    virtual int available(void) = 0;
+
+    // Read up to len bytes which are already available into dest. Must not wait for more data to arrive.
+    // Returns the number of bytes read.
+    virtual size_t read(char *dest, size_t len) = 0;
+
+    // Write len bytes from src. Returns the number of bytes written.
+    virtual size_t write(const char *src, size_t len) = 0;
+
+    // Write as much of src as the link will accept without waiting. Returns the number of bytes written, which may be
+    // zero if the link is full (e.g. held off by hardware flow control). Used by the driver's TX queue.
+    // The default calls write, which may wait
+    virtual size_t tryWrite(const char *src, size_t len)
+    {
+        return write(src, len);
+    }
+
+    // Write count segments, in order, as a single operation. Returns the total number of bytes written.
+    // The default calls write for each segment. Override it if the link can gather (writev, DMA descriptor chains...)
+    virtual size_t writev(const UBX_CELL_iovec_t *iov, int count)
+    {
+        size_t written = 0;
+        for (int i = 0; i < count; i++)
+        {
+            size_t numWritten = write(iov[i].data, iov[i].len);
+            written += numWritten;
+            if (numWritten < iov[i].len)
+                break;
+        }
+        return written;
+    }
+};
+
+#endif // SFE_UBLOX_CELLULAR_TRANSPORT_H
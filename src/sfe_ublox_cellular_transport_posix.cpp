@@ -0,0 +1,288 @@
+#include "sfe_ublox_cellular_transport_posix.h"
+
+#ifdef UBX_CELL_POSIX_TRANSPORT_ENABLED
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <termios.h>
+#include <unistd.h>
+
+SparkFun_ublox_Cellular_Transport_POSIX::SparkFun_ublox_Cellular_Transport_POSIX()
+{
+    _fd = -1;
+    _ownsFd = false;
+    _isTTY = false;
+    _writeTimeout = 1000;
+}
+
+SparkFun_ublox_Cellular_Transport_POSIX::~SparkFun_ublox_Cellular_Transport_POSIX()
+{
+    close();
+}
+
+bool SparkFun_ublox_Cellular_Transport_POSIX::openSerial(const char *device)
+{
+    int fd = ::open(device, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0)
+        return false;
+
+    if (isatty(fd))
+    {
+        struct termios tio;
+        if (tcgetattr(fd, &tio) == 0)
+        {
+            cfmakeraw(&tio);
+            tio.c_cflag |= (CLOCAL | CREAD);
+            tio.c_cc[VMIN] = 0;
+            tio.c_cc[VTIME] = 0;
+            tcsetattr(fd, TCSANOW, &tio);
+        }
+    }
+
+    return attach(fd, true);
+}
+
+bool SparkFun_ublox_Cellular_Transport_POSIX::openSocket(const char *path)
+{
+    struct sockaddr_un addr;
+
+    if (strlen(path) >= sizeof(addr.sun_path))
+        return false;
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return false;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+
+    if (::connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    return attach(fd, true);
+}
+
+bool SparkFun_ublox_Cellular_Transport_POSIX::attach(int fd, bool takeOwnership)
+{
+    if (fd < 0)
+        return false;
+
+    close();
+
+    // The driver polls. Reads and writes must never block
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags >= 0)
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+
+    _fd = fd;
+    _ownsFd = takeOwnership;
+    _isTTY = (isatty(fd) != 0);
+    return true;
+}
+
+void SparkFun_ublox_Cellular_Transport_POSIX::close(void)
+{
+    if ((_fd >= 0) && _ownsFd)
+        ::close(_fd);
+    _fd = -1;
+    _ownsFd = false;
+    _isTTY = false;
+}
+
+void SparkFun_ublox_Cellular_Transport_POSIX::begin(unsigned long baud)
+{
+    if ((_fd < 0) || (!_isTTY))
+        return;
+
+    speed_t speed;
+    switch (baud)
+    {
+    case 9600:
+        speed = B9600;
+        break;
+    case 19200:
+        speed = B19200;
+        break;
+    case 38400:
+        speed = B38400;
+        break;
+    case 57600:
+        speed = B57600;
+        break;
+    case 115200:
+        speed = B115200;
+        break;
+    case 230400:
+        speed = B230400;
+        break;
+#ifdef B460800
+    case 460800:
+        speed = B460800;
+        break;
+#endif
+#ifdef B921600
+    case 921600:
+        speed = B921600;
+        break;
+#endif
+    default:
+        return; // Not a rate termios knows about. Leave the line alone
+    }
+
+    struct termios tio;
+    if (tcgetattr(_fd, &tio) != 0)
+        return;
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tcsetattr(_fd, TCSADRAIN, &tio);
+}
+
+void SparkFun_ublox_Cellular_Transport_POSIX::end(void)
+{
+    // Nothing to do. The descriptor stays open across baud rate changes
+}
+
+int SparkFun_ublox_Cellular_Transport_POSIX::available(void)
+{
+    if (_fd < 0)
+        return -1;
+
+    int avail = 0;
+    if (ioctl(_fd, FIONREAD, &avail) != 0)
+        return -1;
+    return avail;
+}
+
+size_t SparkFun_ublox_Cellular_Transport_POSIX::read(char *dest, size_t len)
+{
+    if ((_fd < 0) || (len == 0))
+        return 0;
+
+    ssize_t numRead = ::read(_fd, dest, len);
+    if (numRead < 0) // EAGAIN (nothing to read) or a real error. Either way, nothing was read
+        return 0;
+    return (size_t)numRead;
+}
+
+size_t SparkFun_ublox_Cellular_Transport_POSIX::write(const char *src, size_t len)
+{
+    size_t written = 0;
+
+    if (_fd < 0)
+        return 0;
+
+    while (written < len)
+    {
+        ssize_t numWritten = ::write(_fd, src + written, len - written);
+        if (numWritten > 0)
+        {
+            written += numWritten;
+        }
+        else if ((numWritten < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+        {
+            break; // A real error
+        }
+        else
+        {
+            // The descriptor is full. Wait for it to drain
+            struct pollfd pfd;
+            pfd.fd = _fd;
+            pfd.events = POLLOUT;
+            pfd.revents = 0;
+            if (::poll(&pfd, 1, (int)_writeTimeout) <= 0)
+                break; // Timed out
+        }
+    }
+
+    return written;
+}
+
+size_t SparkFun_ublox_Cellular_Transport_POSIX::tryWrite(const char *src, size_t len)
+{
+    if ((_fd < 0) || (len == 0))
+        return 0;
+
+    ssize_t numWritten = ::write(_fd, src, len);
+    if (numWritten < 0) // EAGAIN (the descriptor is full) or a real error. Either way, nothing was written
+        return 0;
+    return (size_t)numWritten;
+}
+
+size_t SparkFun_ublox_Cellular_Transport_POSIX::writev(const UBX_CELL_iovec_t *iov, int count)
+{
+    size_t written = 0;
+    struct iovec vec[8];
+    int first = 0;        // The first segment which has not been written completely
+    size_t firstDone = 0; // How much of it has been written
+
+    if (_fd < 0)
+        return 0;
+
+    while (first < count)
+    {
+        // Gather as many of the remaining segments as vec will hold
+        int numVec = 0;
+        for (int i = first; (i < count) && (numVec < 8); i++)
+        {
+            size_t skip = (i == first) ? firstDone : 0;
+            vec[numVec].iov_base = (void *)(iov[i].data + skip);
+            vec[numVec].iov_len = iov[i].len - skip;
+            numVec++;
+        }
+
+        ssize_t numWritten = ::writev(_fd, vec, numVec);
+        if (numWritten > 0)
+        {
+            written += numWritten;
+            // Step over the segments which are now complete
+            size_t remaining = (size_t)numWritten;
+            while ((first < count) && (remaining >= (iov[first].len - firstDone)))
+            {
+                remaining -= iov[first].len - firstDone;
+                firstDone = 0;
+                first++;
+            }
+            firstDone += remaining;
+        }
+        else if ((numWritten < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+        {
+            break; // A real error
+        }
+        else if (numWritten < 0)
+        {
+            // The descriptor is full. Wait for it to drain
+            struct pollfd pfd;
+            pfd.fd = _fd;
+            pfd.events = POLLOUT;
+            pfd.revents = 0;
+            if (::poll(&pfd, 1, (int)_writeTimeout) <= 0)
+                break; // Timed out
+        }
+        else
+        {
+            // Nothing written and no error. Step over any empty segments, but give up if there is still data to send:
+            // trying again would only spin
+            while ((first < count) && (iov[first].len == firstDone))
+            {
+                firstDone = 0;
+                first++;
+            }
+            if (first < count)
+                break;
+        }
+    }
+
+    return written;
+}
+
+#endif // UBX_CELL_POSIX_TRANSPORT_ENABLED
@@ -0,0 +1,57 @@
+#ifndef SFE_UBLOX_CELLULAR_TRANSPORT_POSIX_H
+#define SFE_UBLOX_CELLULAR_TRANSPORT_POSIX_H
+
+#include "sfe_ublox_cellular_transport.h"
+
+#if defined(__unix__) || defined(__APPLE__) // Linux, macOS, BSD... host builds
+#define UBX_CELL_POSIX_TRANSPORT_ENABLED    // Enable the POSIX transport
+#endif
+
+#ifdef UBX_CELL_POSIX_TRANSPORT_ENABLED
+
+// Transport over a POSIX file descriptor.
+// Use this to run the driver on a Linux gateway (a serial tty such as /dev/ttyUSB0), or on a PC against a pty or a
+// Unix domain socket provided by a modem simulator.
+class SparkFun_ublox_Cellular_Transport_POSIX : public SparkFun_ublox_Cellular_Transport
+{
+  public:
+    SparkFun_ublox_Cellular_Transport_POSIX();
+    ~SparkFun_ublox_Cellular_Transport_POSIX();
+
+    // Open a serial tty or pty (e.g. /dev/ttyUSB0 or /dev/pts/3). The line is put into raw mode.
+    // The baud rate is set by begin
+    bool openSerial(const char *device);
+
+    // Connect to a Unix domain stream socket at path
+    bool openSocket(const char *path);
+
+    // Use a descriptor which is already open, e.g. one end of a socketpair or a pty master.
+    // If takeOwnership is true, the descriptor is closed by close() and by the destructor
+    bool attach(int fd, bool takeOwnership = false);
+
+    void close(void);
+
+    int fd(void)
+    {
+        return _fd;
+    }
+
+    // Set the baud rate of a tty. Ignored for sockets and ptys which do not support it
+    void begin(unsigned long baud) override;
+    void end(void) override;
+    int available(void) override;
+    size_t read(char *dest, size_t len) override;
+    size_t write(const char *src, size_t len) override;
+    size_t writev(const UBX_CELL_iovec_t *iov, int count) override; // One writev(2) call where possible
+    size_t tryWrite(const char *src, size_t len) override;          // One nonblocking write(2) call
+
+  protected:
+    int _fd;
+    bool _ownsFd;
+    bool _isTTY;
+    unsigned long _writeTimeout; // Milliseconds write will wait for the descriptor to become writable
+};
+
+#endif // UBX_CELL_POSIX_TRANSPORT_ENABLED
+
+#endif // SFE_UBLOX_CELLULAR_TRANSPORT_POSIX_H